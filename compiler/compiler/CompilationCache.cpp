@@ -0,0 +1,66 @@
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+#include "compiler/CompilationCache.hpp"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace Kebab {
+
+CompilationCache::CompilationCache(const std::string &directory) : directory(directory) {
+  std::error_code error_code;
+  std::filesystem::create_directories(this->directory, error_code);
+  if (error_code)
+    CompilationCache::error("could not create " + directory + ": " + error_code.message());
+}
+
+[[noreturn]] void CompilationCache::error(const std::string &message) {
+  std::cerr << "cache-error: " << message << std::endl;
+
+  exit(1);
+}
+
+std::filesystem::path CompilationCache::get_path(const std::string &key) const {
+  std::array<uint8_t, 32> hash = llvm::SHA256::hash(llvm::arrayRefFromStringRef(key));
+  return this->directory / (llvm::toHex(hash, true) + ".o");
+}
+
+std::unique_ptr<llvm::MemoryBuffer> CompilationCache::load(const std::string &key) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> object =
+      llvm::MemoryBuffer::getFile(this->get_path(key).string());
+  if (!object) {
+    ++this->misses;
+    return nullptr;
+  }
+
+  ++this->hits;
+  return std::move(object.get());
+}
+
+void CompilationCache::store(const std::string &key, llvm::StringRef object) const {
+  // Entries are written to a file of their own and renamed into place, so other builds never read
+  // one that is half written. Failing to store an entry only means it misses again next time
+  std::string path = this->get_path(key).string();
+  llvm::SmallString<128> temporary_path;
+  int fd;
+  if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%%%.tmp", fd, temporary_path))
+    return;
+
+  llvm::raw_fd_ostream stream(fd, true);
+  stream << object;
+  stream.close();
+  if (stream.has_error() || llvm::sys::fs::rename(temporary_path, path)) {
+    stream.clear_error();
+    llvm::sys::fs::remove(temporary_path);
+  }
+}
+
+} // namespace Kebab
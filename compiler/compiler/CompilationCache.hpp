@@ -0,0 +1,45 @@
+#ifndef KEBAB_COMPILATIONCACHE_HPP
+#define KEBAB_COMPILATIONCACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#pragma clang diagnostic pop
+
+namespace Kebab {
+
+// Object code kept on disk between builds. Entries are named by a hash of everything that went into
+// generating them, so they are never invalidated: any change gives a new key that misses instead
+class CompilationCache {
+private:
+  std::filesystem::path directory;
+  std::atomic<size_t> hits = 0;
+  std::atomic<size_t> misses = 0;
+
+  [[noreturn]] static void error(const std::string &message);
+
+  std::filesystem::path get_path(const std::string &key) const;
+
+public:
+  explicit CompilationCache(const std::string &directory);
+
+  // Null (and counted as a miss) if nothing was stored for `key` yet
+  std::unique_ptr<llvm::MemoryBuffer> load(const std::string &key);
+  // Several builds can share the directory, entries are only visible once they are complete
+  void store(const std::string &key, llvm::StringRef object) const;
+
+  size_t get_hits() const { return this->hits; }
+
+  size_t get_misses() const { return this->misses; }
+};
+
+} // namespace Kebab
+
+#endif
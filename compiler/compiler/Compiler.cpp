@@ -1,9 +1,14 @@
 #include <cassert>
 #include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <system_error>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -11,8 +16,13 @@
 #include "compiler/Errors.hpp"
 #include "parser/Constructor.hpp"
 #include "parser/RootNode.hpp"
+#include "parser/Statement.hpp"
+#include "parser/Type.hpp"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Argument.h"
 #include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/CallingConv.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -20,49 +30,293 @@
 #include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
 #include "llvm/IR/ValueSymbolTable.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetOptions.h"
+#include "llvm/TargetParser/Host.h"
 
 namespace Kebab {
 
 // TODO: user defined global variables
 
-void Compiler::compile(std::unique_ptr<Parser::RootNode> root, const std::string &output_path) {
+void Compiler::compile(std::unique_ptr<Parser::RootNode> root, const std::string &output_path,
+                       OutputType output_type) {
+  if (output_type == OutputType::OBJECT || output_type == OutputType::ASSEMBLY)
+    this->initialize_target();
+
+  this->build_module(*root);
+  this->save_module(output_path, output_type);
+}
+
+llvm::orc::ThreadSafeModule Compiler::compile_for_jit(std::unique_ptr<Parser::RootNode> root) {
+  // The JIT generates native code for the host so optimize for it as well
+  this->initialize_target();
+  this->build_module(*root);
+
+  return llvm::orc::ThreadSafeModule(std::move(this->mod), std::move(this->context));
+}
+
+void Compiler::build_module(const Parser::RootNode &root) {
+  std::vector<const Parser::Statement *> statements;
+  for (const std::unique_ptr<Parser::Statement> &statement : root.statements)
+    statements.push_back(statement.get());
+  this->build_module(statements);
+}
+
+void Compiler::build_module(const std::vector<const Parser::Statement *> &statements) {
+  this->generate_module(statements);
+  this->optimize_module();
+}
+
+void Compiler::generate_module(const std::vector<const Parser::Statement *> &statements) {
   this->declare_extern_functions();
-  root->compile(*this);
-  this->save_module(output_path);
+  this->define_len();
+  for (const Parser::Statement *statement : statements)
+    statement->compile(*this);
+
+  // Builtins are only kept if the program uses them
+  if (llvm::Function *len = this->mod->getFunction("len"); len->use_empty())
+    len->eraseFromParent();
+}
+
+[[noreturn]] void Compiler::error(const std::string &message) {
+  std::cerr << "compiler-error: " << message << std::endl;
+
+  exit(1);
+}
+
+void Compiler::initialize_target() {
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+
+  std::string triple = llvm::sys::getDefaultTargetTriple();
+  std::string lookup_error;
+  const llvm::Target *target = llvm::TargetRegistry::lookupTarget(triple, lookup_error);
+  if (target == nullptr)
+    Compiler::error("could not find target for " + triple + ": " + lookup_error);
+
+  llvm::CodeGenOptLevel codegen_level;
+  if (this->optimization_level == llvm::OptimizationLevel::O0)
+    codegen_level = llvm::CodeGenOptLevel::None;
+  else if (this->optimization_level == llvm::OptimizationLevel::O1)
+    codegen_level = llvm::CodeGenOptLevel::Less;
+  else if (this->optimization_level == llvm::OptimizationLevel::O2)
+    codegen_level = llvm::CodeGenOptLevel::Default;
+  else
+    codegen_level = llvm::CodeGenOptLevel::Aggressive;
+
+  // Generic cpu so objects behave the same as the ones clang would have produced from the IR
+  llvm::TargetOptions options;
+  this->target_machine.reset(target->createTargetMachine(triple, "generic", "", options,
+                                                         llvm::Reloc::PIC_, std::nullopt,
+                                                         codegen_level));
+
+  this->mod->setTargetTriple(triple);
+  this->mod->setDataLayout(this->target_machine->createDataLayout());
 }
 
 llvm::Value *Compiler::create_list(const std::vector<llvm::Value *> &list, llvm::Type *type) {
-  // Calculate total size in bytes
-  llvm::ConstantInt *list_size =
-      this->create_int(list.size() * (type->getPrimitiveSizeInBits() / 8));
+  // Calculate total size in bytes, elements can be aggregates (e.g. closures) so use their size in
+  // memory rather than their size in bits
+  llvm::StructType *list_type = this->get_list_type(type, list.size());
+  const llvm::DataLayout &layout = this->mod->getDataLayout();
+  llvm::ConstantInt *list_size = this->create_int(layout.getTypeAllocSize(list_type));
+
+  ListInfo info = {type, this->get_closure_signature(list.front()), nullptr, list.size()};
+  // Nested lists can have different lengths, so only the rest of the information is shared
+  if (auto it = this->list_infos.find(list.front()); it != this->list_infos.end()) {
+    ListInfo elements = it->second;
+    elements.length = std::nullopt;
+    info.elements = std::make_shared<const ListInfo>(elements);
+  }
+
+  // Nothing can mutate a list, so lists of constants are shared by everything creating them
+  if (llvm::Constant *constant_list = this->create_constant_list(list, type)) {
+    this->list_infos[constant_list] = info;
+    return constant_list;
+  }
 
   // Allocate memory
   std::vector<llvm::Value *> malloc_args = {list_size};
-  llvm::CallInst *alloc =
-      std::get<llvm::CallInst *>(this->create_call(this->mod.getFunction("malloc"), malloc_args));
-  llvm::Value *typed_alloc = this->builder.CreateBitCast(alloc, type->getPointerTo());
-
-  // Fill list allocation with initializers
+  llvm::Value *alloc =
+      std::get<llvm::Value *>(this->create_call(this->mod->getFunction("malloc"), malloc_args));
+  // The list may be moved to an arena once we know whether it outlives the constructor
+  if (!this->arena_scopes.empty())
+    this->arena_scopes.back().list_allocations.push_back(llvm::cast<llvm::CallInst>(alloc));
+
+  // Fill list allocation with its length and initializers
+  this->create_store(this->create_int(list.size()),
+                     this->builder.CreateStructGEP(list_type, alloc, 0));
+  llvm::ConstantInt *index0 = this->create_int(0);
+  llvm::Value *elements_field = this->builder.getInt32(1);
   for (size_t i = 0; i < list.size(); ++i) {
-    llvm::Value *elementPtr = this->builder.CreateGEP(type, typed_alloc, this->create_int(i));
+    llvm::Value *elementPtr =
+        this->builder.CreateGEP(list_type, alloc, {index0, elements_field, this->create_int(i)});
     this->create_store(list[i], elementPtr);
   }
 
   // Store information about list for later use (this information is not stored in the value itself
   // so it will get lost if we dont store it somewhere)
-  this->list_infos[typed_alloc] = {type, list_size};
-  return typed_alloc;
+  this->list_infos[alloc] = info;
+  return alloc;
+}
+
+llvm::Constant *Compiler::create_constant_list(const std::vector<llvm::Value *> &list,
+                                               llvm::Type *type) {
+  std::vector<llvm::Constant *> elements;
+  for (llvm::Value *element : list) {
+    auto *constant = llvm::dyn_cast<llvm::Constant>(element);
+    if (constant == nullptr)
+      return nullptr;
+    elements.push_back(constant);
+  }
+
+  llvm::StructType *list_type = this->get_list_type(type, list.size());
+  llvm::Constant *elements_initializer =
+      llvm::ConstantArray::get(llvm::ArrayType::get(type, list.size()), elements);
+  llvm::Constant *initializer =
+      llvm::ConstantStruct::get(list_type, {this->create_int(list.size()), elements_initializer});
+
+  auto *global = new llvm::GlobalVariable(*this->mod, list_type, true,
+                                          llvm::GlobalValue::PrivateLinkage, initializer);
+  global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+  global->setAlignment(this->get_alignment(list_type));
+
+  return global;
+}
+
+llvm::StructType *Compiler::get_list_type(llvm::Type *element_type, uint64_t length) {
+  return llvm::StructType::get(*this->context,
+                               {this->get_int_type(), llvm::ArrayType::get(element_type, length)});
 }
 
-void Compiler::save_module(const std::string &path) const {
+std::optional<Compiler::ListInfo> Compiler::get_list_info(const Parser::Type &type) {
+  const auto *list_type = dynamic_cast<const Parser::ListType *>(&type);
+  if (list_type == nullptr)
+    return std::nullopt;
+
+  // Functions are stored as closure values, which take their environment as the last argument
+  const Parser::Type &content_type = *list_type->content_type;
+  if (const auto *function_type = dynamic_cast<const Parser::FunctionType *>(&content_type)) {
+    llvm::PointerType *ptr_type = this->builder.getPtrTy();
+    llvm::StructType *closure_type = llvm::StructType::get(*this->context, {ptr_type, ptr_type});
+    return ListInfo{closure_type,
+                    this->add_parameter(function_type->get_llvm_type(*this), ptr_type)};
+  }
+
+  ListInfo info = {content_type.get_llvm_type(*this)};
+  if (std::optional<ListInfo> elements = this->get_list_info(content_type); elements.has_value())
+    info.elements = std::make_shared<const ListInfo>(elements.value());
+
+  return info;
+}
+
+void Compiler::create_bounds_check(llvm::Value *list, llvm::Value *index) {
+  llvm::Function *function = this->get_current_function();
+  llvm::BasicBlock *out_of_bounds = this->create_basic_block(function, "index_out_of_bounds");
+  llvm::BasicBlock *in_bounds = this->create_basic_block(function, "index_in_bounds");
+
+  // Negative indices are huge when compared unsigned, so one comparison checks both ends
+  llvm::Value *length = this->create_load(this->get_int_type(), list);
+  this->create_cond_branch(this->builder.CreateICmpULT(index, length), in_bounds, out_of_bounds);
+
+  this->set_insert_point(out_of_bounds);
+  llvm::FunctionCallee index_error = this->get_runtime_function(
+      "kebab_index_error",
+      llvm::FunctionType::get(this->get_void_type(), {this->get_int_type(), this->get_int_type()},
+                              false));
+  llvm::CallInst *call = this->builder.CreateCall(index_error, {index, length});
+  call->setDoesNotReturn();
+  this->builder.CreateUnreachable();
+
+  this->set_insert_point(in_bounds);
+}
+
+llvm::Value *Compiler::create_closure_value(llvm::Function *function) {
+  // Every closure value takes an environment so they can all be called the same way
+  llvm::Function *callee = function;
+  llvm::Value *environment = llvm::ConstantPointerNull::get(this->builder.getPtrTy());
+  if (this->has_closure_environment(function))
+    environment = this->get_closure_environment(function);
+  else
+    callee = this->get_closure_trampoline(function);
+
+  llvm::StructType *closure_type =
+      llvm::StructType::get(*this->context, {callee->getType(), environment->getType()});
+  llvm::Value *closure = llvm::UndefValue::get(closure_type);
+  closure = this->builder.CreateInsertValue(closure, callee, {0});
+  closure = this->builder.CreateInsertValue(closure, environment, {1}, "closure");
+
+  this->closure_signatures[closure] = callee->getFunctionType();
+  return closure;
+}
+
+void Compiler::optimize_module() {
+  // Unoptimized builds emit the module exactly as it was generated
+  if (this->optimization_level == llvm::OptimizationLevel::O0)
+    return;
+
+  llvm::LoopAnalysisManager loop_analysis_manager;
+  llvm::FunctionAnalysisManager function_analysis_manager;
+  llvm::CGSCCAnalysisManager cgscc_analysis_manager;
+  llvm::ModuleAnalysisManager module_analysis_manager;
+
+  // target_machine is null unless we're emitting native code, which makes the pipeline fall back
+  // to target independent defaults
+  llvm::PassBuilder pass_builder(this->target_machine.get());
+  pass_builder.registerModuleAnalyses(module_analysis_manager);
+  pass_builder.registerCGSCCAnalyses(cgscc_analysis_manager);
+  pass_builder.registerFunctionAnalyses(function_analysis_manager);
+  pass_builder.registerLoopAnalyses(loop_analysis_manager);
+  pass_builder.crossRegisterProxies(loop_analysis_manager, function_analysis_manager,
+                                    cgscc_analysis_manager, module_analysis_manager);
+
+  llvm::ModulePassManager module_pass_manager =
+      pass_builder.buildPerModuleDefaultPipeline(this->optimization_level);
+  module_pass_manager.run(*this->mod, module_analysis_manager);
+}
+
+void Compiler::emit_native(llvm::raw_pwrite_stream &stream, llvm::CodeGenFileType file_type) {
+  assert(this->target_machine != nullptr && "target should be initialized before emitting");
+
+  // Code generation is still only exposed through the legacy pass manager
+  llvm::legacy::PassManager pass_manager;
+  if (this->target_machine->addPassesToEmitFile(pass_manager, stream, nullptr, file_type))
+    Compiler::error("target machine cannot emit files of the requested type");
+
+  pass_manager.run(*this->mod);
+}
+
+void Compiler::save_module(const std::string &path, OutputType output_type) {
   std::error_code error_code;
-  llvm::raw_fd_stream fd(path, error_code);
-  this->mod.print(fd, nullptr);
+  llvm::raw_fd_ostream stream(path, error_code);
+  if (error_code)
+    Compiler::error("could not open output file " + path + ": " + error_code.message());
+
+  switch (output_type) {
+  case OutputType::LLVM_IR:
+    this->mod->print(stream, nullptr);
+    break;
+
+  case OutputType::BITCODE:
+    llvm::WriteBitcodeToFile(*this->mod, stream);
+    break;
+
+  case OutputType::OBJECT:
+    this->emit_native(stream, llvm::CodeGenFileType::ObjectFile);
+    break;
+
+  case OutputType::ASSEMBLY:
+    this->emit_native(stream, llvm::CodeGenFileType::AssemblyFile);
+    break;
+  }
 }
 
 void Compiler::declare_printf() {
@@ -93,6 +347,28 @@ void Compiler::declare_extern_functions() {
   this->declare_malloc();
 }
 
+void Compiler::define_len() {
+  // The signature of this function is `i64 len(ptr)`, the length is the first field of a list
+  llvm::FunctionType *prototype =
+      llvm::FunctionType::get(this->get_int_type(), {this->builder.getPtrTy()}, false);
+  llvm::Function *len =
+      llvm::Function::Create(prototype, llvm::Function::PrivateLinkage, "len", *this->mod);
+  this->current_scope->put("len", len, prototype);
+  this->add_effect_attributes(len, {Effect::READS_MEMORY, true});
+
+  llvm::Argument *list = len->getArg(0);
+  list->setName("list");
+  llvm::IRBuilder<> len_builder(this->create_basic_block(len, "entry"));
+  llvm::LoadInst *length = len_builder.CreateLoad(this->get_int_type(), list, "length");
+  length->setAlignment(this->get_alignment(this->get_int_type()));
+  len_builder.CreateRet(length);
+}
+
+llvm::FunctionCallee Compiler::get_runtime_function(const std::string &name,
+                                                    llvm::FunctionType *type) {
+  return this->mod->getOrInsertFunction(name, type);
+}
+
 std::variant<llvm::Type *, UnrecognizedTypeError>
 Compiler::get_primitive_type(const std::string &type_name) const {
   if (auto error = UnrecognizedTypeError::check(this->primitive_types, type_name);
@@ -110,33 +386,204 @@ llvm::Value *Compiler::int_to_float(llvm::Value *i) {
 
 llvm::Function *Compiler::declare_function(llvm::FunctionType *type, const std::string &name) {
   llvm::Function *function =
-      llvm::Function::Create(type, llvm::Function::ExternalLinkage, name, this->mod);
+      llvm::Function::Create(type, llvm::Function::ExternalLinkage, name, *this->mod);
 
   this->current_scope->put(name, function, type);
 
   return function;
 }
 
+std::vector<std::string>
+Compiler::find_captures(const std::string &name, const std::set<std::string> &referenced_names) {
+  std::set<std::string> needed = referenced_names;
+  // Calling another closure requires its environment, so a pointer to it has to be captured here
+  for (const std::string &referenced : referenced_names) {
+    auto binding = this->current_scope->lookup(referenced);
+    if (referenced == name || !binding.has_value())
+      continue;
+
+    if (auto *callee = llvm::dyn_cast<llvm::Function>(binding->value);
+        callee != nullptr && this->has_closure_environment(callee))
+      needed.insert("env:" + callee->getName().str());
+  }
+
+  // Functions and names that are not bound in the enclosing scope (e.g. locals of the function)
+  // are not part of the environment
+  std::vector<std::string> captures;
+  for (const auto &bindings = this->current_scope->bindings();
+       const auto &[key, binding] : bindings)
+    if (needed.contains(key))
+      captures.push_back(key);
+
+  return captures;
+}
+
+bool Compiler::has_closure_environment(const llvm::Function *function) const {
+  return this->closures.contains(function);
+}
+
+void Compiler::create_closure_environment(const llvm::Function *function) {
+  const Closure &closure = this->closures.at(function);
+  std::string name = "env:" + function->getName().str();
+
+  // The environment is filled in once here, calls only pass a pointer to it
+  llvm::AllocaInst *environment = this->create_entry_alloca(closure.environment_type, name);
+  for (unsigned int i = 0, size = closure.captures.size(); i < size; ++i) {
+    auto binding = this->current_scope->lookup(closure.captures[i]);
+    assert(binding.has_value() && "captures are always bound in the enclosing scope");
+
+    llvm::Value *field = this->builder.CreateStructGEP(closure.environment_type, environment, i);
+    this->create_store(binding->value, field);
+    if (i == 0)
+      this->allocation_sites[environment] = llvm::cast<llvm::Instruction>(field);
+  }
+
+  this->current_scope->put(name, environment, environment->getType());
+}
+
+llvm::Value *Compiler::get_closure_environment(const llvm::Function *function) const {
+  // Whatever the function captures is bound where it is called, either because it was defined
+  // there or because the caller captures the environment as well
+  auto binding = this->current_scope->lookup("env:" + function->getName().str());
+  assert(binding.has_value() && "environments are visible wherever the closure can be called");
+
+  return binding->value;
+}
+
+llvm::Function *Compiler::get_closure_trampoline(llvm::Function *function) {
+  if (auto it = this->closure_trampolines.find(function); it != this->closure_trampolines.end())
+    return it->second;
+
+  llvm::FunctionType *prototype =
+      this->add_parameter(function->getFunctionType(), this->builder.getPtrTy());
+  llvm::Function *trampoline =
+      llvm::Function::Create(prototype, llvm::Function::InternalLinkage,
+                             function->getName() + ".closure", *this->mod);
+  trampoline->setCallingConv(llvm::CallingConv::Tail);
+  if (auto it = this->function_effects.find(function); it != this->function_effects.end())
+    this->add_effect_attributes(trampoline, it->second);
+  trampoline->getArg(trampoline->arg_size() - 1)->setName("closure-env");
+
+  // Trampolines are generated whenever a function is first used as a value, which can be in the
+  // middle of another function, so they get their own builder
+  llvm::IRBuilder<> trampoline_builder(this->create_basic_block(trampoline, "entry"));
+  std::vector<llvm::Value *> arguments;
+  for (unsigned int i = 0, size = function->arg_size(); i < size; ++i) {
+    trampoline->getArg(i)->setName(function->getArg(i)->getName());
+    arguments.push_back(trampoline->getArg(i));
+  }
+
+  llvm::CallInst *call = trampoline_builder.CreateCall(function, arguments);
+  call->setCallingConv(function->getCallingConv());
+  call->setTailCallKind(llvm::CallInst::TCK_Tail);
+  if (call->getType()->isVoidTy())
+    trampoline_builder.CreateRetVoid();
+  else
+    trampoline_builder.CreateRet(call);
+
+  this->closure_trampolines[function] = trampoline;
+  return trampoline;
+}
+
+llvm::Function *Compiler::get_task_function(llvm::Function *function,
+                                            llvm::StructType *frame_type) {
+  if (auto it = this->task_functions.find(function); it != this->task_functions.end())
+    return it->second;
+
+  // Tasks are called by the runtime so they follow the C ABI
+  llvm::Function *task = llvm::Function::Create(
+      llvm::FunctionType::get(this->get_void_type(), {this->builder.getPtrTy()}, false),
+      llvm::Function::InternalLinkage, function->getName() + ".task", *this->mod);
+  task->setDoesNotThrow();
+  llvm::Argument *frame = task->getArg(0);
+  frame->setName("frame");
+
+  // Like trampolines these can be generated in the middle of another function
+  llvm::IRBuilder<> task_builder(this->create_basic_block(task, "entry"));
+  std::vector<llvm::Value *> arguments;
+  for (unsigned int i = 0, size = function->arg_size(); i < size; ++i) {
+    llvm::Type *type = frame_type->getElementType(i);
+    arguments.push_back(task_builder.CreateAlignedLoad(
+        type, task_builder.CreateStructGEP(frame_type, frame, i), this->get_alignment(type),
+        function->getArg(i)->getName()));
+  }
+
+  llvm::CallInst *call = task_builder.CreateCall(function, arguments);
+  call->setCallingConv(function->getCallingConv());
+  task_builder.CreateAlignedStore(
+      call, task_builder.CreateStructGEP(frame_type, frame, function->arg_size()),
+      this->get_alignment(call->getType()));
+  task_builder.CreateRetVoid();
+
+  this->task_functions[function] = task;
+  return task;
+}
+
+std::string Compiler::describe_declaration(const std::string &name) const {
+  std::string description;
+  llvm::raw_string_ostream stream(description);
+
+  // Memoized functions are called through their cache
+  for (const llvm::Function *function :
+       {this->mod->getFunction(name), this->mod->getFunction(name + ".memo")}) {
+    if (function == nullptr)
+      continue;
+
+    stream << function->getName() << ' ' << function->getCallingConv() << ' '
+           << *function->getFunctionType() << ' '
+           << function->getAttributes().getAsString(llvm::AttributeList::FunctionIndex) << '\n';
+    if (auto it = this->closures.find(function); it != this->closures.end())
+      for (const std::string &capture : it->second.captures)
+        stream << "capture " << capture << '\n';
+
+    auto it = this->returned_list_infos.find(function);
+    for (const ListInfo *info = it != this->returned_list_infos.end() ? &it->second : nullptr;
+         info != nullptr; info = info->elements.get()) {
+      stream << "list " << *info->type;
+      if (info->signature != nullptr)
+        stream << " of " << *info->signature;
+      if (info->length.has_value())
+        stream << " length " << info->length.value();
+      stream << '\n';
+    }
+  }
+
+  return description;
+}
+
 void Compiler::load_arguments(
     const llvm::Function *function,
     const std::vector<std::unique_ptr<Parser::FunctionParameter>> &parameters) {
-  // Load and add fields of closure into scope
-  // unsigned int because type is required by CreateExtractValue(), bindings.size - parameters.size
-  // since bindings are expanded by parameters and we dont want to add these in the closure
-  llvm::Argument *closure_arg = function->getArg(function->arg_size() - 1);
-  closure_arg->setName("closure-env");
-
-  std::vector<std::pair<const std::string &, Scope::Binding>> bindings =
-      this->current_scope->bindings();
-
-  for (unsigned int i = 0, size = bindings.size(); i < size; ++i) {
-    const auto &[name, binding] = bindings[i];
-    llvm::Value *field = this->builder.CreateExtractValue(closure_arg, {i}, "closure-env:" + name);
-    llvm::AllocaInst *field_pointer = this->create_alloca("closure-env:" + name + "-ptr", field,
-                                                          field->getType()->getPointerTo());
-    llvm::LoadInst *field_loaded = this->create_load(field_pointer->getType(), field_pointer);
+  // Add fields of closure into scope. unsigned int because type is required by
+  // CreateStructGEP()
+  if (this->has_closure_environment(function)) {
+    llvm::Argument *closure_arg = function->getArg(function->arg_size() - 1);
+    closure_arg->setName("closure-env");
+
+    const Closure &closure = this->closures.at(function);
+    for (unsigned int i = 0, size = closure.captures.size(); i < size; ++i) {
+      const std::string &name = closure.captures[i];
+      auto binding = this->current_scope->lookup(name);
+      assert(binding.has_value() && "captures are always bound in the enclosing scope");
+
+      // Immutable bindings are captured by value and mutable bindings by a pointer to their stack
+      // slot, either way the field can be bound directly the same way it was in the enclosing
+      // scope
+      llvm::StructType *environment_type = closure.environment_type;
+      llvm::Value *field_ptr = this->builder.CreateStructGEP(environment_type, closure_arg, i);
+      llvm::Value *field = this->create_load(environment_type->getElementType(i), field_ptr);
+      field->setName("closure-env:" + name);
+      if (this->list_infos.contains(binding->value))
+        this->list_infos[field] = this->list_infos[binding->value];
+      if (this->closure_signatures.contains(binding->value))
+        this->closure_signatures[field] = this->closure_signatures[binding->value];
+
+      this->current_scope->put(name, field, binding->type, binding->is_mutable);
+    }
 
-    this->current_scope->put(name, field_loaded, binding.type, binding.is_mutable);
+    // Recursive calls pass the environment along
+    this->current_scope->put("env:" + function->getName().str(), closure_arg,
+                             closure_arg->getType());
   }
 
   // Set parameter names and bring parameters into scope of function
@@ -144,26 +591,132 @@ void Compiler::load_arguments(
     llvm::Argument *argument = function->getArg(i);
     argument->setName(parameters[i]->name);
 
-    llvm::AllocaInst *argument_alloca =
-        this->create_alloca("arg:" + parameters[i]->name, argument, argument->getType());
-
     // TODO: mutability for parameters maybe with mut keyword for mutable params. This would have to
-    // be changed in parser as well. For now just make all parameters const
-    this->current_scope->put(parameters[i]->name, argument_alloca, argument->getType());
+    // be changed in parser as well. For now just make all parameters const, which means they can be
+    // used directly without a stack slot
+    this->current_scope->put(parameters[i]->name, argument, argument->getType());
+    if (std::optional<ListInfo> info = this->get_list_info(*parameters[i]->type); info.has_value())
+      this->list_infos[argument] = info.value();
+  }
+}
+
+FunctionEffects Compiler::resolve_effects(const std::string &name, const Effects &effects,
+                                          bool is_closure) const {
+  FunctionEffects resolved = {effects.effect, effects.always_returns};
+  // Closures read their environment, and bindings outside of the function can only be assigned
+  // through it
+  if (is_closure)
+    resolved.effect = combine_effects(resolved.effect, Effect::READS_MEMORY);
+  if (!effects.assigned_names.empty())
+    resolved.effect = Effect::SIDE_EFFECTS;
+
+  for (const std::string &called : effects.called_names) {
+    // Recursion may never end
+    if (called == name) {
+      resolved.always_returns = false;
+      continue;
+    }
+
+    // Anything other than a function defined by the program (e.g. printf or a closure value) could
+    // do anything
+    auto binding = this->current_scope->lookup(called);
+    const auto *callee =
+        binding.has_value() ? llvm::dyn_cast<llvm::Function>(binding->value) : nullptr;
+    auto it = this->function_effects.find(callee);
+    if (callee == nullptr || it == this->function_effects.end()) {
+      resolved.effect = Effect::SIDE_EFFECTS;
+      resolved.always_returns = false;
+      continue;
+    }
+
+    resolved.effect = combine_effects(resolved.effect, it->second.effect);
+    resolved.always_returns = resolved.always_returns && it->second.always_returns;
   }
+
+  return resolved;
 }
 
-llvm::Function *Compiler::define_function(
+void Compiler::add_effect_attributes(llvm::Function *function, FunctionEffects effects) {
+  this->function_effects[function] = effects;
+
+  // Kebab has no exceptions, nothing ever unwinds
+  function->setDoesNotThrow();
+  if (effects.effect == Effect::PURE)
+    function->setDoesNotAccessMemory();
+  else if (effects.effect == Effect::READS_MEMORY)
+    function->setOnlyReadsMemory();
+
+  if (effects.always_returns)
+    function->addFnAttr(llvm::Attribute::WillReturn);
+}
+
+std::variant<llvm::Function *, MemoizationError> Compiler::define_function(
     const llvm::FunctionType *function_type, const std::string &name,
     const Parser::Constructor &body,
-    const std::vector<std::unique_ptr<Parser::FunctionParameter>> &parameters) {
+    const std::vector<std::unique_ptr<Parser::FunctionParameter>> &parameters,
+    const std::set<std::string> &referenced_names, const Effects &effects, bool is_memoized) {
+  // Top level functions are the ones defined while no other function is being compiled
+  bool is_top_level = this->get_insert_block() == nullptr;
+  bool is_defined_elsewhere = false;
+  if (is_top_level && this->partition.has_value())
+    is_defined_elsewhere =
+        this->top_level_function_count++ % this->partition->count != this->partition->index;
+
   this->start_scope();
 
-  llvm::StructType *closure_type = this->create_closure_type();
-  llvm::FunctionType *function_type_with_closure = this->add_parameter(function_type, closure_type);
+  // Functions that dont capture anything dont get an environment parameter at all, the others get
+  // a pointer to it
+  std::vector<std::string> captures = this->find_captures(name, referenced_names);
+  llvm::FunctionType *prototype =
+      captures.empty() ? llvm::FunctionType::get(function_type->getReturnType(),
+                                                 function_type->params(), function_type->isVarArg())
+                       : this->add_parameter(function_type, this->builder.getPtrTy());
+
+  FunctionEffects resolved_effects = this->resolve_effects(name, effects, !captures.empty());
+  // The functions called by declarations may not be declared themselves
+  if (is_defined_elsewhere && this->partition->effects != nullptr)
+    resolved_effects = this->partition->effects->at(name);
+  if (is_memoized) {
+    // Only the partition defining the function reports errors in it
+    if (auto error = MemoizationError::check(prototype, resolved_effects.effect);
+        error.has_value() && !is_defined_elsewhere) {
+      this->end_scope();
+      return error.value();
+    }
+    // The cache is written by every call
+    resolved_effects.effect = Effect::SIDE_EFFECTS;
+  }
 
+  // Only main (and top level functions, if other partitions call them) is called from outside the
+  // module. Every other function is internal, so LLVM is free to drop, specialize or change the
+  // signature of it across the whole program
+  bool is_exported = name == "main" || (is_top_level && this->partition.has_value());
+  // Other modules refer to exported functions by their name, so local functions that got it first
+  // are renamed
+  if (llvm::Function *local = this->mod->getFunction(name); is_exported && local != nullptr)
+    local->setName(name + ".local");
   llvm::Function *function = llvm::Function::Create(
-      function_type_with_closure, llvm::Function::ExternalLinkage, name, this->mod);
+      prototype, is_exported ? llvm::Function::ExternalLinkage : llvm::Function::InternalLinkage,
+      name, *this->mod);
+  if (!captures.empty()) {
+    llvm::StructType *environment_type = this->create_closure_type(captures);
+    this->closures[function] = {std::move(captures), environment_type};
+  }
+  this->add_effect_attributes(function, resolved_effects);
+  // tailcc guarantees that calls marked as tail calls in tail position reuse the caller's frame,
+  // main keeps the C calling convention since it is called from outside the module
+  if (name != "main")
+    function->setCallingConv(llvm::CallingConv::Tail);
+  if (std::optional<ListInfo> info = this->get_list_info(*body.get_type()); info.has_value())
+    this->returned_list_infos[function] = info.value();
+
+  // Functions of other partitions are left as declarations, their definitions are linked in
+  if (is_defined_elsewhere) {
+    this->end_scope();
+    llvm::Function *callee = is_memoized ? this->create_memoized_function(function) : function;
+    this->current_scope->put(name, callee, callee->getFunctionType());
+    return callee;
+  }
 
   // Make entry for new function and save the current insert block so we can return to it after
   // we're done compiling the current function
@@ -173,29 +726,120 @@ llvm::Function *Compiler::define_function(
   // Codegen for the body of the function
   this->set_insert_point(entry);
   this->load_arguments(function, parameters);
-  // For recursion the function needs to be defined within its own scope
-  this->current_scope->put(name, function, function->getFunctionType());
-  this->builder.CreateRet(body.compile(*this));
+  // For recursion the function needs to be defined within its own scope. Calls of memoized
+  // functions (recursive ones included) go through the cache
+  llvm::Function *callee = is_memoized ? this->create_memoized_function(function) : function;
+  this->current_scope->put(name, callee, callee->getFunctionType());
+  llvm::Value *return_value = body.compile(*this);
+  // Every path may have already returned if the body ends in tail calls
+  if (!this->is_block_terminated())
+    this->create_return(return_value);
+  this->move_escaping_slots_to_heap(function);
   this->set_insert_point(previous_block);
 
   this->end_scope();
-  this->current_scope->put(name, function, function->getFunctionType());
+  this->current_scope->put(name, callee, callee->getFunctionType());
+  if (this->has_closure_environment(function))
+    this->create_closure_environment(function);
 
-  return function;
+  return callee;
+}
+
+llvm::Function *Compiler::create_memoized_function(llvm::Function *function) {
+  llvm::Function *memoized =
+      llvm::Function::Create(function->getFunctionType(), function->getLinkage(),
+                             function->getName() + ".memo", *this->mod);
+  memoized->setCallingConv(llvm::CallingConv::Tail);
+  this->add_effect_attributes(memoized, {Effect::SIDE_EFFECTS, false});
+  if (function->isDeclaration())
+    return memoized;
+
+  // The cache is a direct mapped table, each entry holds whether it is filled, the arguments it
+  // belongs to (as integers) and the result
+  std::vector<llvm::Type *> fields(function->arg_size() + 2, this->builder.getInt64Ty());
+  fields.front() = this->builder.getInt1Ty();
+  fields.back() = function->getReturnType();
+  llvm::StructType *entry_type = llvm::StructType::get(*this->context, fields);
+  llvm::ArrayType *table_type = llvm::ArrayType::get(entry_type, Compiler::memo_table_size);
+  auto *table = new llvm::GlobalVariable(*this->mod, table_type, false,
+                                         llvm::GlobalValue::InternalLinkage,
+                                         llvm::ConstantAggregateZero::get(table_type),
+                                         function->getName() + ".memo-table");
+
+  // Like trampolines these can be generated in the middle of another function
+  llvm::IRBuilder<> memo_builder(this->create_basic_block(memoized, "entry"));
+  auto load = [this, &memo_builder](llvm::Type *type, llvm::Value *pointer) {
+    return memo_builder.CreateAlignedLoad(type, pointer, this->get_alignment(type));
+  };
+  auto store = [this, &memo_builder](llvm::Value *value, llvm::Value *pointer) {
+    memo_builder.CreateAlignedStore(value, pointer, this->get_alignment(value->getType()));
+  };
+  std::vector<llvm::Value *> arguments;
+  std::vector<llvm::Value *> keys;
+  llvm::Value *hash = memo_builder.getInt64(0);
+  for (unsigned int i = 0, size = function->arg_size(); i < size; ++i) {
+    llvm::Argument *argument = memoized->getArg(i);
+    argument->setName(function->getArg(i)->getName());
+    arguments.push_back(argument);
+
+    // Arguments are compared by their bits, so e.g. -0.0 and 0.0 get their own entries
+    llvm::Value *key = argument->getType()->isDoubleTy()
+                           ? memo_builder.CreateBitCast(argument, memo_builder.getInt64Ty())
+                           : memo_builder.CreateZExt(argument, memo_builder.getInt64Ty());
+    keys.push_back(key);
+    hash = memo_builder.CreateMul(i == 0 ? key : memo_builder.CreateXor(hash, key),
+                                  memo_builder.getInt64(0x9e3779b97f4a7c15));
+  }
+
+  // The multiplications mix the arguments into the top bits the most
+  llvm::Value *index = memo_builder.CreateLShr(hash, 64 - Compiler::memo_table_bits);
+  llvm::Value *entry =
+      memo_builder.CreateInBoundsGEP(table_type, table, {memo_builder.getInt64(0), index});
+  llvm::Value *is_cached =
+      load(memo_builder.getInt1Ty(), memo_builder.CreateStructGEP(entry_type, entry, 0));
+  for (unsigned int i = 0, size = keys.size(); i < size; ++i) {
+    llvm::Value *key =
+        load(memo_builder.getInt64Ty(), memo_builder.CreateStructGEP(entry_type, entry, i + 1));
+    is_cached = memo_builder.CreateAnd(is_cached, memo_builder.CreateICmpEQ(key, keys[i]));
+  }
+  llvm::Value *result_field = memo_builder.CreateStructGEP(entry_type, entry, keys.size() + 1);
+
+  llvm::BasicBlock *cached = this->create_basic_block(memoized, "cached");
+  llvm::BasicBlock *uncached = this->create_basic_block(memoized, "uncached");
+  memo_builder.CreateCondBr(is_cached, cached, uncached);
+
+  memo_builder.SetInsertPoint(cached);
+  memo_builder.CreateRet(load(function->getReturnType(), result_field));
+
+  // Whatever was in the entry before is replaced
+  memo_builder.SetInsertPoint(uncached);
+  llvm::CallInst *result = memo_builder.CreateCall(function, arguments);
+  result->setCallingConv(function->getCallingConv());
+  store(memo_builder.getTrue(), memo_builder.CreateStructGEP(entry_type, entry, 0));
+  for (unsigned int i = 0, size = keys.size(); i < size; ++i)
+    store(keys[i], memo_builder.CreateStructGEP(entry_type, entry, i + 1));
+  store(result, result_field);
+  memo_builder.CreateRet(result);
+
+  return memoized;
 }
 
 llvm::Align Compiler::get_alignment(llvm::Type *type) const {
-  const llvm::DataLayout &layout = this->mod.getDataLayout();
+  const llvm::DataLayout &layout = this->mod->getDataLayout();
   return layout.getPrefTypeAlign(type);
 }
 
-llvm::StructType *Compiler::create_closure_type() {
+llvm::StructType *Compiler::create_closure_type(const std::vector<std::string> &captures) {
+  // Mutable bindings are captured by reference so assignments inside the closure are visible to the
+  // enclosing scope, immutable bindings can just be copied into the closure
   std::vector<llvm::Type *> types;
-  for (const auto &bindings = this->current_scope->bindings();
-       const auto &[key, binding] : bindings)
-    types.push_back(binding.type->getPointerTo());
+  for (const std::string &name : captures) {
+    auto binding = this->current_scope->lookup(name);
+    assert(binding.has_value() && "captures are always bound in the enclosing scope");
+    types.push_back(binding->is_mutable ? binding->type->getPointerTo() : binding->type);
+  }
 
-  auto closure_type = llvm::StructType::get(this->context, types);
+  auto closure_type = llvm::StructType::get(*this->context, types);
   closure_type->setName("closure-env");
 
   return closure_type;
@@ -208,28 +852,27 @@ llvm::FunctionType *Compiler::add_parameter(const llvm::FunctionType *type, llvm
   return llvm::FunctionType::get(type->getReturnType(), param_types, type->isVarArg());
 }
 
-llvm::Value *Compiler::create_closure_argument(llvm::StructType *closure_type) {
-  llvm::Value *closure_argument = llvm::UndefValue::get(closure_type);
+llvm::AllocaInst *Compiler::create_entry_alloca(llvm::Type *type, const std::string &name) {
+  // Slots in the entry block are allocated once per call no matter how often the code defining
+  // them runs (e.g. in the loops of tail recursion)
+  llvm::BasicBlock &entry = this->get_current_function()->getEntryBlock();
+  llvm::BasicBlock::iterator position = entry.begin();
+  while (position != entry.end() && llvm::isa<llvm::AllocaInst>(*position))
+    ++position;
 
-  std::vector<std::pair<const std::string &, Scope::Binding>> bindings =
-      this->current_scope->bindings();
-  for (unsigned int i = 0, num_elements = closure_type->getNumElements(); i < num_elements; ++i) {
-    llvm::Value *field_value = bindings[i].second.value;
-    closure_argument = this->builder.CreateInsertValue(closure_argument, field_value, {i});
-  }
-  closure_argument->setName("closure-arg");
+  llvm::IRBuilder<> entry_builder(&entry, position);
+  llvm::AllocaInst *local = entry_builder.CreateAlloca(type, nullptr, name);
+  local->setAlignment(this->get_alignment(type));
 
-  return closure_argument;
+  return local;
 }
 
 llvm::AllocaInst *Compiler::create_alloca(const std::string &name, llvm::Value *init,
                                           llvm::Type *type) {
-  llvm::Align alignment = this->get_alignment(type);
-  llvm::AllocaInst *local = this->builder.CreateAlloca(type, nullptr, name);
-  local->setAlignment(alignment);
-
-  llvm::StoreInst *store = this->builder.CreateStore(init, local);
-  store->setAlignment(alignment);
+  llvm::AllocaInst *local = this->create_entry_alloca(type, name);
+  this->allocation_sites[local] = this->create_store(init, local);
+  if (!this->arena_scopes.empty())
+    this->arena_scopes.back().slots.insert(local);
 
   return local;
 }
@@ -268,17 +911,32 @@ llvm::StoreInst *Compiler::create_store(llvm::Value *init, llvm::Value *dest) {
   return store;
 }
 
-std::variant<llvm::AllocaInst *, RedefinitionError>
+std::variant<llvm::Value *, RedefinitionError>
 Compiler::create_definition(const std::string &name, llvm::Value *init, bool is_mutable) {
   if (auto error = RedefinitionError::check(*this->current_scope, name); error.has_value())
     return error.value();
 
+  // Immutable bindings can never change so they are bound directly to their ssa value, only mutable
+  // bindings need a stack slot
+  if (!is_mutable) {
+    if (llvm::isa<llvm::Instruction>(init) && !init->hasName())
+      init->setName(name);
+
+    this->current_scope->put(name, init, init->getType(), is_mutable);
+    return init;
+  }
+
   llvm::AllocaInst *local = this->create_alloca(name, init, init->getType());
   this->current_scope->put(name, local, init->getType(), is_mutable);
 
-  // If we're creating a pointer to a list, copy the list info as well
-  if (this->list_infos.contains(init))
+  // If we're creating a pointer to a list, copy the list info as well. Other lists can be assigned
+  // to the binding later so its length is only known at runtime
+  if (this->list_infos.contains(init)) {
     this->list_infos[local] = this->list_infos[init];
+    this->list_infos[local].length = std::nullopt;
+  }
+  if (this->closure_signatures.contains(init))
+    this->closure_signatures[local] = this->closure_signatures[init];
 
   return local;
 }
@@ -330,11 +988,27 @@ std::variant<llvm::Value *, UnaryOperatorError> Compiler::create_not(llvm::Value
 }
 
 llvm::Value *Compiler::create_subscription(llvm::Value *list, llvm::Value *offset) {
-  llvm::Type *list_type = this->list_infos[list].type;
-  assert(list_type != nullptr && "missing type info for list");
-  llvm::Value *element_ptr = this->builder.CreateGEP(list_type, list, offset);
-
-  return this->create_load(list_type, element_ptr);
+  auto it = this->list_infos.find(list);
+  assert(it != this->list_infos.end() && "missing type info for list");
+  ListInfo info = it->second;
+
+  // Indices known to be in range while compiling dont need to be checked again at runtime
+  auto *constant_offset = llvm::dyn_cast<llvm::ConstantInt>(offset);
+  if (constant_offset == nullptr || !info.length.has_value() ||
+      constant_offset->getZExtValue() >= info.length.value())
+    this->create_bounds_check(list, offset);
+
+  // The number of elements is not part of the type, indexing past the end of an empty array is fine
+  llvm::StructType *list_type = this->get_list_type(info.type, 0);
+  llvm::Value *element_ptr = this->builder.CreateGEP(
+      list_type, list, {this->create_int(0), this->builder.getInt32(1), offset});
+  llvm::LoadInst *element = this->create_load(info.type, element_ptr);
+  if (info.signature != nullptr)
+    this->closure_signatures[element] = info.signature;
+  if (info.elements != nullptr)
+    this->list_infos[element] = *info.elements;
+
+  return element;
 }
 
 std::variant<llvm::Value *, BinaryOperatorError> Compiler::create_add(llvm::Value *lhs,
@@ -538,32 +1212,63 @@ std::variant<llvm::Value *, BinaryOperatorError> Compiler::create_ge(llvm::Value
     return this->builder.CreateICmpSGE(lhs, rhs);
 }
 
-std::variant<llvm::Value *, BinaryOperatorError> Compiler::create_and(llvm::Value *lhs,
-                                                                      llvm::Value *rhs) {
-  const llvm::Type *lhs_type = lhs->getType();
-  const llvm::Type *rhs_type = rhs->getType();
+std::variant<llvm::Value *, BinaryOperatorError>
+Compiler::create_short_circuit(llvm::Value *lhs, const std::function<llvm::Value *()> &compile_rhs,
+                               bool short_circuit_value, const std::string &operator_name) {
   const llvm::Type *bool_type = this->get_bool_type();
+  if (lhs->getType() != bool_type)
+    return BinaryOperatorError(lhs->getType(), compile_rhs()->getType(), operator_name);
 
-  if (lhs_type == bool_type && rhs_type == bool_type)
-    return this->builder.CreateAnd(lhs, rhs);
+  // If lhs is known at compile time we either never need the rhs or the rhs is the result
+  if (auto *constant_lhs = llvm::dyn_cast<llvm::ConstantInt>(lhs)) {
+    if (constant_lhs->isOne() == short_circuit_value)
+      return lhs;
+
+    llvm::Value *rhs = compile_rhs();
+    if (rhs->getType() != bool_type)
+      return BinaryOperatorError(lhs->getType(), rhs->getType(), operator_name);
+
+    return rhs;
+  }
+
+  llvm::Function *function = this->get_current_function();
+  llvm::BasicBlock *lhs_block = this->builder.GetInsertBlock();
+  llvm::BasicBlock *rhs_block = this->create_basic_block(function, operator_name + "_rhs");
+  llvm::BasicBlock *merge_block = this->create_basic_block(function, operator_name + "_merge");
+
+  if (short_circuit_value)
+    this->create_cond_branch(lhs, merge_block, rhs_block);
   else
-    return BinaryOperatorError(lhs_type, rhs_type, "and");
+    this->create_cond_branch(lhs, rhs_block, merge_block);
+
+  this->set_insert_point(rhs_block);
+  llvm::Value *rhs = compile_rhs();
+  if (rhs->getType() != bool_type)
+    return BinaryOperatorError(lhs->getType(), rhs->getType(), operator_name);
+
+  // Compiling the rhs may have introduced new blocks (e.g. nested cond expressions) so the phi
+  // needs to come from wherever the rhs ended up
+  llvm::BasicBlock *rhs_end_block = this->builder.GetInsertBlock();
+  this->create_branch(merge_block);
+
+  this->set_insert_point(merge_block);
+  llvm::Constant *short_circuited = this->create_bool(short_circuit_value);
+  return this->create_phi(this->get_bool_type(),
+                          {{short_circuited, lhs_block}, {rhs, rhs_end_block}});
 }
 
-std::variant<llvm::Value *, BinaryOperatorError> Compiler::create_or(llvm::Value *lhs,
-                                                                     llvm::Value *rhs) {
-  const llvm::Type *lhs_type = lhs->getType();
-  const llvm::Type *rhs_type = rhs->getType();
-  const llvm::Type *bool_type = this->get_bool_type();
+std::variant<llvm::Value *, BinaryOperatorError>
+Compiler::create_and(llvm::Value *lhs, const std::function<llvm::Value *()> &compile_rhs) {
+  return this->create_short_circuit(lhs, compile_rhs, false, "and");
+}
 
-  if (lhs_type == bool_type && rhs_type == bool_type)
-    return this->builder.CreateOr(lhs, rhs);
-  else
-    return BinaryOperatorError(lhs_type, rhs_type, "or");
+std::variant<llvm::Value *, BinaryOperatorError>
+Compiler::create_or(llvm::Value *lhs, const std::function<llvm::Value *()> &compile_rhs) {
+  return this->create_short_circuit(lhs, compile_rhs, true, "or");
 }
 
 llvm::BasicBlock *Compiler::create_basic_block(llvm::Function *parent, const std::string &name) {
-  return llvm::BasicBlock::Create(this->context, name, parent);
+  return llvm::BasicBlock::Create(*this->context, name, parent);
 }
 
 llvm::BranchInst *Compiler::create_branch(llvm::BasicBlock *destination) {
@@ -588,47 +1293,532 @@ Compiler::create_phi(llvm::Type *type,
 }
 
 bool Compiler::is_externally_defined(const llvm::Function *function) const {
-  // TODO: more sophisticated structure, probably a hashmap from name to functions
-  const std::string function_name = function->getName().str();
-  if (function_name == "printf" || function_name == "malloc")
-    return true;
-  else
-    return false;
+  // libc and runtime functions are only declared, every user defined function has a body (even
+  // while it is being generated, since the entry block is created first) unless another partition
+  // defines it. Those still have known effects
+  return function->isDeclaration() && !this->function_effects.contains(function);
 }
 
-std::variant<llvm::CallInst *, ArgumentCountError>
+std::variant<llvm::Value *, ArgumentCountError>
 Compiler::create_extern_call(llvm::Function *function,
                              const std::vector<llvm::Value *> &arguments) {
-  if (auto error = ArgumentCountError::check(function, arguments.size()); error.has_value())
+  if (auto error = ArgumentCountError::check(function->getFunctionType(), arguments.size());
+      error.has_value())
     return error.value();
 
   return this->builder.CreateCall(function, arguments);
 }
 
-std::variant<llvm::CallInst *, ArgumentCountError>
-Compiler::create_userdefined_call(llvm::Function *function, std::vector<llvm::Value *> &arguments) {
-  if (auto error = ArgumentCountError::check(function, arguments.size() + 1); error.has_value())
+std::variant<llvm::Value *, ArgumentCountError>
+Compiler::create_userdefined_call(llvm::Function *function, std::vector<llvm::Value *> &arguments,
+                                  bool is_tail_call) {
+  bool has_closure_environment = this->has_closure_environment(function);
+  if (auto error = ArgumentCountError::check(function->getFunctionType(), arguments.size(),
+                                             has_closure_environment);
+      error.has_value())
     return error.value();
 
-  // Last argument is the closure struct
-  const llvm::Argument *closure_arg = function->getArg(function->arg_size() - 1);
-  llvm::Type *closure_type = closure_arg->getType();
-  if (auto closure_type_casted = llvm::dyn_cast<llvm::StructType>(closure_type)) {
-    arguments.push_back(this->create_closure_argument(closure_type_casted));
+  if (is_tail_call && function == this->get_current_function())
+    return this->create_self_tail_call(function, arguments);
+
+  // Last argument is a pointer to the closure environment
+  if (has_closure_environment)
+    arguments.push_back(this->get_closure_environment(function));
+
+  llvm::CallInst *call = this->builder.CreateCall(function, arguments);
+  call->setCallingConv(function->getCallingConv());
+  if (auto it = this->returned_list_infos.find(function); it != this->returned_list_infos.end())
+    this->list_infos[call] = it->second;
+  return this->complete_call(call, is_tail_call);
+}
+
+llvm::Value *Compiler::complete_call(llvm::CallInst *call, bool is_tail_call) {
+  if (!is_tail_call || this->has_stack_slots(this->get_current_function()))
+    return call;
+
+  call->setTailCallKind(llvm::CallInst::TCK_Tail);
+  this->create_return(call);
+  return call;
+}
+
+Compiler::TailRecursion &Compiler::get_tail_recursion(llvm::Function *function) {
+  if (auto it = this->tail_recursions.find(function); it != this->tail_recursions.end())
+    return it->second;
+
+  // Everything generated so far moves into the header, except for stack slots which stay in the
+  // entry block so every iteration reuses the same ones
+  llvm::BasicBlock *entry = &function->getEntryBlock();
+  llvm::BasicBlock *header =
+      llvm::BasicBlock::Create(*this->context, "tail_recursion", function, entry->getNextNode());
+
+  std::vector<llvm::Instruction *> moved;
+  for (llvm::Instruction &instruction : *entry)
+    if (!llvm::isa<llvm::AllocaInst>(instruction))
+      moved.push_back(&instruction);
+  for (llvm::Instruction *instruction : moved)
+    instruction->moveBefore(*header, header->end());
+
+  if (header->getTerminator() != nullptr)
+    header->replaceSuccessorsPhiUsesWith(entry, header);
+  llvm::BranchInst::Create(header, entry);
+  if (this->get_insert_block() == entry)
+    this->set_insert_point(header);
+
+  TailRecursion &recursion = this->tail_recursions[function];
+  recursion.header = header;
+
+  // The closure environment (the last argument) is the same for every iteration
+  unsigned int parameter_count = function->arg_size() - this->has_closure_environment(function);
+  llvm::IRBuilder<> header_builder(header, header->begin());
+  for (unsigned int i = 0; i < parameter_count; ++i) {
+    llvm::Argument *argument = function->getArg(i);
+    llvm::PHINode *parameter =
+        header_builder.CreatePHI(argument->getType(), 2, "tail-recursion:" + argument->getName());
+    argument->replaceAllUsesWith(parameter);
+    parameter->addIncoming(argument, entry);
+
+    this->current_scope->replace(argument, parameter);
+    recursion.parameters.push_back(parameter);
+  }
+
+  return recursion;
+}
 
-    return this->builder.CreateCall(function, arguments);
-  } else {
-    assert(false && "last argument to a user defined function should always be the closure");
+llvm::Value *Compiler::create_self_tail_call(llvm::Function *function,
+                                             const std::vector<llvm::Value *> &arguments) {
+  TailRecursion &recursion = this->get_tail_recursion(function);
+  for (size_t i = 0, size = arguments.size(); i < size; ++i) {
+    // Arguments compiled before the header existed may still refer to the original parameters
+    llvm::Value *argument = arguments[i];
+    if (auto *parameter = llvm::dyn_cast<llvm::Argument>(argument);
+        parameter != nullptr && parameter->getParent() == function)
+      argument = recursion.parameters[parameter->getArgNo()];
+
+    recursion.parameters[i]->addIncoming(argument, this->get_insert_block());
   }
+
+  this->create_branch(recursion.header);
+
+  // The block is terminated so the result of the call can never be used
+  return llvm::UndefValue::get(function->getReturnType());
+}
+
+bool Compiler::has_stack_slots(const llvm::Function *function) const {
+  for (const llvm::BasicBlock &block : *function)
+    for (const llvm::Instruction &instruction : block)
+      if (const auto *slot = llvm::dyn_cast<llvm::AllocaInst>(&instruction);
+          slot != nullptr && !this->stack_lists.contains(slot))
+        return true;
+
+  return false;
+}
+
+// Calls to user defined functions can be followed into the callee since it is already generated
+static const llvm::Function *get_followable_callee(const llvm::CallInst *call) {
+  const llvm::Function *callee = call->getCalledFunction();
+  if (callee == nullptr || callee->isDeclaration() || callee->isVarArg())
+    return nullptr;
+
+  return callee;
 }
 
-std::variant<llvm::CallInst *, ArgumentCountError>
-Compiler::create_call(llvm::Function *function, std::vector<llvm::Value *> &arguments) {
+bool Compiler::escapes(const llvm::Value *pointer, EscapeVisits &visited) const {
+  // Cycles (e.g. recursion) dont make anything escape on their own, other uses still might
+  if (!visited.insert({pointer, false}).second)
+    return false;
+
+  for (const llvm::User *user : pointer->users()) {
+    if (llvm::isa<llvm::LoadInst>(user))
+      continue;
+
+    if (llvm::isa<llvm::GetElementPtrInst>(user)) {
+      if (this->escapes(user, visited))
+        return true;
+      continue;
+    }
+
+    if (const auto *store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+      if (store->getValueOperand() == pointer &&
+          this->stored_pointers_escape(store->getPointerOperand(), visited))
+        return true;
+      continue;
+    }
+
+    if (const auto *call = llvm::dyn_cast<llvm::CallInst>(user)) {
+      const llvm::Function *callee = get_followable_callee(call);
+      if (callee == nullptr)
+        return true;
+
+      for (unsigned int i = 0, size = call->arg_size(); i < size; ++i)
+        if (call->getArgOperand(i) == pointer && this->escapes(callee->getArg(i), visited))
+          return true;
+      continue;
+    }
+
+    // Returned, put into a closure value or anything else we cant follow
+    return true;
+  }
+
+  return false;
+}
+
+bool Compiler::stored_pointers_escape(const llvm::Value *memory, EscapeVisits &visited) const {
+  // Only stack slots can be followed, anything else (e.g. lists on the heap) may be reachable from
+  // anywhere
+  const llvm::Value *base = memory->stripInBoundsOffsets();
+  if (!llvm::isa<llvm::AllocaInst>(base))
+    return true;
+
+  return this->escapes(base, visited) || this->loaded_pointers_escape(base, visited);
+}
+
+bool Compiler::loaded_pointers_escape(const llvm::Value *memory, EscapeVisits &visited) const {
+  if (!visited.insert({memory, true}).second)
+    return false;
+
+  for (const llvm::User *user : memory->users()) {
+    if (const auto *load = llvm::dyn_cast<llvm::LoadInst>(user)) {
+      if (load->getType()->isAggregateType())
+        return true;
+      if (load->getType()->isPointerTy() &&
+          (this->escapes(load, visited) || this->loaded_pointers_escape(load, visited)))
+        return true;
+      continue;
+    }
+
+    if (llvm::isa<llvm::GetElementPtrInst>(user)) {
+      if (this->loaded_pointers_escape(user, visited))
+        return true;
+      continue;
+    }
+
+    if (const auto *store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+      if (store->getValueOperand() == memory &&
+          this->stored_pointers_escape(store->getPointerOperand(), visited))
+        return true;
+      continue;
+    }
+
+    if (const auto *call = llvm::dyn_cast<llvm::CallInst>(user)) {
+      const llvm::Function *callee = get_followable_callee(call);
+      if (callee == nullptr)
+        return true;
+
+      for (unsigned int i = 0, size = call->arg_size(); i < size; ++i)
+        if (call->getArgOperand(i) == memory &&
+            this->loaded_pointers_escape(callee->getArg(i), visited))
+          return true;
+      continue;
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+void Compiler::start_constructor_scope() {
+  this->start_scope();
+
+  // Constructors outside of functions (e.g. global definitions) have nowhere to free an arena
+  llvm::BasicBlock *block = this->get_insert_block();
+  if (block == nullptr) {
+    this->arena_scopes.push_back({nullptr, nullptr, nullptr, {}, {}});
+    return;
+  }
+
+  llvm::Instruction *start_instruction = block->empty() ? nullptr : &block->back();
+  this->arena_scopes.push_back({block, start_instruction, &block->getParent()->back(), {}, {}});
+}
+
+void Compiler::end_constructor_scope(llvm::Value *result) {
+  this->end_scope();
+
+  ArenaScope scope = std::move(this->arena_scopes.back());
+  this->arena_scopes.pop_back();
+  if (scope.start_block == nullptr)
+    return;
+
+  // Small lists that cannot outlive the body go on the stack, larger ones into an arena. Bodies
+  // that can be left early would have to free the arena on every way out, so they use the heap
+  bool has_early_exit = this->has_early_exit(scope);
+  std::vector<llvm::CallInst *> arena_lists;
+  std::vector<llvm::CallInst *> heap_lists;
+  for (llvm::CallInst *allocation : scope.list_allocations) {
+    std::set<const llvm::Value *> visited;
+    bool is_local = this->is_scope_local(allocation, result, scope, visited);
+    auto *size = llvm::cast<llvm::ConstantInt>(allocation->getArgOperand(0));
+    if (is_local && size->getZExtValue() <= Compiler::max_stack_list_size)
+      this->move_list_to_stack(allocation);
+    else if (is_local && !has_early_exit)
+      arena_lists.push_back(allocation);
+    else
+      heap_lists.push_back(allocation);
+  }
+
+  // Everything in the body is inside the enclosing body of the same function as well, so lists
+  // that outlive this body (e.g. the value of a list constructor) may still be local to that one.
+  // This only works if they werent allocated inside an arena that is freed before it ends
+  ArenaScope *parent = this->arena_scopes.empty() ? nullptr : &this->arena_scopes.back();
+  if (parent != nullptr && parent->start_block != nullptr &&
+      parent->start_block->getParent() == this->get_current_function()) {
+    parent->slots.insert(scope.slots.begin(), scope.slots.end());
+    if (arena_lists.empty())
+      parent->list_allocations.insert(parent->list_allocations.end(), heap_lists.begin(),
+                                      heap_lists.end());
+  }
+
+  if (arena_lists.empty())
+    return;
+
+  llvm::PointerType *ptr_type = this->builder.getPtrTy();
+  llvm::FunctionCallee arena_alloc = this->get_runtime_function(
+      "kebab_arena_alloc", llvm::FunctionType::get(ptr_type, this->get_int_type(), false));
+  for (llvm::CallInst *allocation : arena_lists)
+    allocation->setCalledFunction(arena_alloc);
+
+  // Enter the arena where the body starts (after the stack slots, which stay in the entry block)
+  // and free everything allocated in it where the body ends
+  llvm::BasicBlock::iterator start = scope.start_instruction != nullptr
+                                         ? std::next(scope.start_instruction->getIterator())
+                                         : scope.start_block->getFirstInsertionPt();
+  while (start != scope.start_block->end() && llvm::isa<llvm::AllocaInst>(*start))
+    ++start;
+
+  llvm::IRBuilder<> start_builder(scope.start_block, start);
+  llvm::FunctionCallee arena_push =
+      this->get_runtime_function("kebab_arena_push", llvm::FunctionType::get(ptr_type, false));
+  llvm::Value *mark = start_builder.CreateCall(arena_push, {}, "arena");
+
+  llvm::FunctionCallee arena_pop = this->get_runtime_function(
+      "kebab_arena_pop",
+      llvm::FunctionType::get(this->get_void_type(), {ptr_type}, false));
+  this->builder.CreateCall(arena_pop, {mark});
+}
+
+bool Compiler::has_early_exit(const ArenaScope &scope) const {
+  if (this->is_block_terminated())
+    return true;
+
+  const llvm::Function *function = scope.start_block->getParent();
+  auto tail_recursion = this->tail_recursions.find(function);
+  for (auto block = std::next(scope.last_block->getIterator()); block != function->end(); ++block) {
+    const llvm::Instruction *terminator = block->getTerminator();
+    if (terminator == nullptr)
+      continue;
+
+    if (llvm::isa<llvm::ReturnInst>(terminator))
+      return true;
+
+    // Self recursive tail calls loop back to the start of the function
+    if (tail_recursion != this->tail_recursions.end())
+      for (const llvm::BasicBlock *successor : llvm::successors(terminator))
+        if (successor == tail_recursion->second.header)
+          return true;
+  }
+
+  return false;
+}
+
+bool Compiler::is_scope_local(const llvm::Value *pointer, const llvm::Value *result,
+                              const ArenaScope &scope,
+                              std::set<const llvm::Value *> &visited) const {
+  if (pointer == result)
+    return false;
+  if (!visited.insert(pointer).second)
+    return true;
+
+  for (const llvm::User *user : pointer->users()) {
+    // Loads from a list are its elements, which are not the list itself
+    if (llvm::isa<llvm::LoadInst>(user))
+      continue;
+
+    if (llvm::isa<llvm::GetElementPtrInst>(user)) {
+      if (!this->is_scope_local(user, result, scope, visited))
+        return false;
+      continue;
+    }
+
+    if (const auto *store = llvm::dyn_cast<llvm::StoreInst>(user)) {
+      if (store->getPointerOperand() == pointer)
+        continue;
+
+      // Storing into a slot of the body is fine as long as everything loaded from it is local too
+      const auto *slot = llvm::dyn_cast<llvm::AllocaInst>(store->getPointerOperand());
+      if (slot == nullptr || !scope.slots.contains(slot))
+        return false;
+
+      for (const llvm::User *slot_user : slot->users()) {
+        if (const auto *slot_store = llvm::dyn_cast<llvm::StoreInst>(slot_user);
+            slot_store != nullptr && slot_store->getPointerOperand() == slot)
+          continue;
+
+        if (!llvm::isa<llvm::LoadInst>(slot_user) ||
+            !this->is_scope_local(slot_user, result, scope, visited))
+          return false;
+      }
+      continue;
+    }
+
+    if (const auto *call = llvm::dyn_cast<llvm::CallInst>(user)) {
+      // Tail calls outlive the body, since they replace the frame of the function
+      if (call->isTailCall())
+        return false;
+
+      // libc functions dont hold on to their arguments
+      const llvm::Function *called = call->getCalledFunction();
+      if (called != nullptr && this->is_externally_defined(called))
+        continue;
+
+      const llvm::Function *callee = get_followable_callee(call);
+      if (callee == nullptr)
+        return false;
+
+      for (unsigned int i = 0, size = call->arg_size(); i < size; ++i) {
+        EscapeVisits escape_visits;
+        if (call->getArgOperand(i) == pointer && this->escapes(callee->getArg(i), escape_visits))
+          return false;
+      }
+      continue;
+    }
+
+    return false;
+  }
+
+  return true;
+}
+
+void Compiler::move_list_to_stack(llvm::CallInst *allocation) {
+  ListInfo info = this->list_infos.at(allocation);
+  llvm::StructType *list_type = this->get_list_type(info.type, info.length.value());
+
+  llvm::AllocaInst *slot = this->create_entry_alloca(list_type, "");
+  slot->takeName(allocation);
+  allocation->replaceAllUsesWith(slot);
+  allocation->eraseFromParent();
+
+  this->list_infos.erase(allocation);
+  this->list_infos[slot] = info;
+  this->stack_lists.insert(slot);
+}
+
+void Compiler::move_escaping_slots_to_heap(llvm::Function *function) {
+  // Decide which slots escape before changing any of them, since that changes their uses
+  std::vector<llvm::AllocaInst *> escaping;
+  for (llvm::Instruction &instruction : function->getEntryBlock()) {
+    auto *slot = llvm::dyn_cast<llvm::AllocaInst>(&instruction);
+    if (slot == nullptr || !this->allocation_sites.contains(slot))
+      continue;
+
+    EscapeVisits visited;
+    if (this->escapes(slot, visited))
+      escaping.push_back(slot);
+  }
+
+  // Each definition gets a fresh allocation, so closures created in a loop dont share environments
+  const llvm::DataLayout &layout = this->mod->getDataLayout();
+  for (llvm::AllocaInst *slot : escaping) {
+    llvm::IRBuilder<> heap_builder(this->allocation_sites.at(slot));
+    llvm::ConstantInt *size =
+        this->create_int(layout.getTypeAllocSize(slot->getAllocatedType()));
+    llvm::CallInst *allocation = heap_builder.CreateCall(this->mod->getFunction("malloc"), {size});
+    allocation->takeName(slot);
+    slot->replaceAllUsesWith(allocation);
+
+    if (auto it = this->list_infos.find(slot); it != this->list_infos.end()) {
+      this->list_infos[allocation] = it->second;
+      this->list_infos.erase(it);
+    }
+    if (auto it = this->closure_signatures.find(slot); it != this->closure_signatures.end()) {
+      this->closure_signatures[allocation] = it->second;
+      this->closure_signatures.erase(it);
+    }
+    this->allocation_sites.erase(slot);
+    slot->eraseFromParent();
+  }
+}
+
+std::variant<llvm::Value *, ArgumentCountError>
+Compiler::create_call(llvm::Function *function, std::vector<llvm::Value *> &arguments,
+                      bool is_tail_call) {
   // TODO: probably should do type checking here
   if (this->is_externally_defined(function))
     return this->create_extern_call(function, arguments);
   else
-    return this->create_userdefined_call(function, arguments);
+    return this->create_userdefined_call(function, arguments, is_tail_call);
+}
+
+std::variant<llvm::Value *, ArgumentCountError>
+Compiler::create_closure_call(llvm::Value *closure, std::vector<llvm::Value *> &arguments,
+                              bool is_tail_call) {
+  llvm::FunctionType *signature = this->get_closure_signature(closure);
+  assert(signature != nullptr && "only closure values can be called indirectly");
+  if (auto error = ArgumentCountError::check(signature, arguments.size(), true); error.has_value())
+    return error.value();
+
+  llvm::Value *function = this->builder.CreateExtractValue(closure, {0}, "closure-function");
+  arguments.push_back(this->builder.CreateExtractValue(closure, {1}, "closure-env"));
+
+  // Closure values only ever hold user defined functions (or trampolines to them)
+  llvm::CallInst *call = this->builder.CreateCall(signature, function, arguments);
+  call->setCallingConv(llvm::CallingConv::Tail);
+  return this->complete_call(call, is_tail_call);
+}
+
+bool Compiler::is_spawnable(const std::string &name) const {
+  if (!this->parallelize)
+    return false;
+
+  auto binding = this->current_scope->lookup(name);
+  const auto *function = binding.has_value() && !binding->is_mutable
+                             ? llvm::dyn_cast<llvm::Function>(binding->value)
+                             : nullptr;
+  if (function == nullptr || this->has_closure_environment(function))
+    return false;
+
+  // Pure functions that dont always return can only loop forever by calling themselves
+  auto it = this->function_effects.find(function);
+  llvm::Type *type = function->getReturnType();
+  return it != this->function_effects.end() && it->second.effect == Effect::PURE &&
+         !it->second.always_returns && (type->isIntegerTy() || type->isDoubleTy());
+}
+
+std::variant<Compiler::Task, ArgumentCountError>
+Compiler::create_spawn(llvm::Function *function, const std::vector<llvm::Value *> &arguments) {
+  if (auto error = ArgumentCountError::check(function->getFunctionType(), arguments.size());
+      error.has_value())
+    return error.value();
+
+  // The arguments and the result are passed in a frame on the stack of the spawning function
+  std::vector<llvm::Type *> fields = function->getFunctionType()->params();
+  fields.push_back(function->getReturnType());
+  llvm::StructType *frame_type = llvm::StructType::get(*this->context, fields);
+  llvm::AllocaInst *frame = this->create_entry_alloca(frame_type, "task-frame");
+  for (unsigned int i = 0, size = arguments.size(); i < size; ++i)
+    this->create_store(arguments[i], this->builder.CreateStructGEP(frame_type, frame, i));
+
+  // The runtime has state of its own which LLVM has to know the spawning function touches. Calls
+  // of it are still pure as far as anything else is concerned, its tasks end before it returns
+  this->get_current_function()->removeFnAttr(llvm::Attribute::Memory);
+
+  llvm::FunctionCallee spawn = this->get_runtime_function(
+      "kebab_spawn", llvm::FunctionType::get(this->builder.getPtrTy(),
+                                             {this->builder.getPtrTy(), this->builder.getPtrTy()},
+                                             false));
+  llvm::Value *handle = this->builder.CreateCall(
+      spawn, {this->get_task_function(function, frame_type), frame}, "task");
+  return Task{handle, frame, frame_type};
+}
+
+llvm::Value *Compiler::create_join(const Task &task) {
+  llvm::FunctionCallee join = this->get_runtime_function(
+      "kebab_join",
+      llvm::FunctionType::get(this->get_void_type(), {this->builder.getPtrTy()}, false));
+  this->builder.CreateCall(join, {task.handle});
+
+  unsigned int result = task.frame_type->getNumElements() - 1;
+  return this->create_load(task.frame_type->getElementType(result),
+                           this->builder.CreateStructGEP(task.frame_type, task.frame, result));
 }
 
 std::variant<llvm::Value *, NameError> Compiler::get_value(const std::string &name) {
@@ -638,22 +1828,41 @@ std::variant<llvm::Value *, NameError> Compiler::get_value(const std::string &na
   auto existing = this->current_scope->lookup(name);
   assert(existing.has_value() && "lookup failure should be caught by previous error checking");
 
-  // Could add needs_loading to binding struct instead of `isa`. Reason to load LoadInst values is
-  // because these are loaded pointers from closure argument, this is not really clear by the
-  // current implementation since a LoadInst really could be anything
-  // TODO: This is a little messy
-  if (llvm::isa<llvm::AllocaInst>(existing->value) || llvm::isa<llvm::LoadInst>(existing->value)) {
-    // This is for lists - need to copy over list info for loaded pointer
-    if (llvm::isa<llvm::AllocaInst>(existing->value) && existing->value->getType()->isPointerTy()) {
-      llvm::LoadInst *load = this->create_load(existing->type, existing->value);
-      this->list_infos[load] = this->list_infos[existing->value];
-      // HERE - NEED TO LOAD POINTER AND THEN PUT IN LIST INFO BEFORE RETURNING IT
-      return load;
-    } else {
-      return this->create_load(existing->type, existing->value);
-    }
-  } else
+  // Mutable bindings are pointers to their stack slot (or to the stack slot of the enclosing
+  // function if it was captured by a closure), everything else is bound directly to its value
+  if (!existing->is_mutable)
     return existing->value;
+
+  llvm::LoadInst *load = this->create_load(existing->type, existing->value);
+  // This is for lists - need to copy over list info for loaded pointer
+  if (this->list_infos.contains(existing->value))
+    this->list_infos[load] = this->list_infos[existing->value];
+  if (this->closure_signatures.contains(existing->value))
+    this->closure_signatures[load] = this->closure_signatures[existing->value];
+
+  return load;
+}
+
+std::optional<FunctionEffects>
+Compiler::get_function_effects(const llvm::Function *function) const {
+  auto it = this->function_effects.find(function);
+  if (it == this->function_effects.end())
+    return std::nullopt;
+
+  return it->second;
+}
+
+std::optional<uint64_t> Compiler::get_list_length(const llvm::Value *list) const {
+  auto it = this->list_infos.find(list);
+  if (it == this->list_infos.end())
+    return std::nullopt;
+
+  return it->second.length;
+}
+
+llvm::FunctionType *Compiler::get_closure_signature(const llvm::Value *value) const {
+  auto it = this->closure_signatures.find(value);
+  return it != this->closure_signatures.end() ? it->second : nullptr;
 }
 
 } // namespace Kebab
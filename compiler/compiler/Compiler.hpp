@@ -4,15 +4,20 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
 // Disable unused parameter warnings for llvm headers
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunused-parameter"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Constant.h"
 #include "llvm/IR/Constants.h"
@@ -24,24 +29,41 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Passes/OptimizationLevel.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
 #pragma clang diagnostic pop
 
+#include "compiler/Effects.hpp"
 #include "compiler/Errors.hpp"
 #include "compiler/Scope.hpp"
 
 namespace Kebab::Parser {
 // Forward declarations to avoid circular includes
 class RootNode;
+class Statement;
 class Constructor;
 class FunctionParameter;
+class Type;
 } // namespace Kebab::Parser
 
 namespace Kebab {
 
 class Compiler {
+  friend class PartitionedCompiler;
+
+public:
+  enum class OutputType {
+    LLVM_IR,  // .ll
+    BITCODE,  // .bc
+    OBJECT,   // .o
+    ASSEMBLY, // .s
+  };
+
 private:
-  llvm::LLVMContext context;
-  llvm::Module mod; // `module` is a reserved word as of c++20 so cannot use that
+  // The context and module are owned through pointers so they can be handed over to the JIT
+  std::unique_ptr<llvm::LLVMContext> context;
+  std::unique_ptr<llvm::Module> mod; // `module` is a reserved word as of c++20 so cannot use that
   llvm::IRBuilder<> builder;
 
   std::shared_ptr<Scope> current_scope = std::make_shared<Scope>();
@@ -49,22 +71,120 @@ private:
 
   struct ListInfo {
     llvm::Type *type;
-    llvm::Value *size;
+    // Signature of the elements if they are closures, these lose it the same way lists lose theirs
+    llvm::FunctionType *signature = nullptr;
+    // Information about the elements if they are lists themselves
+    std::shared_ptr<const ListInfo> elements = nullptr;
+    // Every list stores its length, this is only set if it is known while compiling as well
+    std::optional<uint64_t> length = std::nullopt;
   };
-  // Lists are heap allocated with opaque pointers so we need to store information about these
-  // pointers before we lose it
-  std::unordered_map<llvm::Value *, ListInfo> list_infos;
-
-  void save_module(const std::string &path) const;
+  // Lists are opaque pointers to their length followed by their elements, so we need to store
+  // information about these pointers before we lose it
+  std::unordered_map<const llvm::Value *, ListInfo> list_infos;
+  // Lists returned by user defined functions, calls to them get this information
+  std::unordered_map<const llvm::Function *, ListInfo> returned_list_infos;
+
+  struct TailRecursion {
+    llvm::BasicBlock *header;
+    // Phis replacing the parameters of the function (excluding the closure environment)
+    std::vector<llvm::PHINode *> parameters;
+  };
+  struct Closure {
+    // Names of the captured bindings, in the order of the fields of the environment
+    std::vector<std::string> captures;
+    llvm::StructType *environment_type;
+  };
+  // User defined functions that capture bindings, these take a pointer to their environment as the
+  // last argument. Functions without captures have no environment
+  std::unordered_map<const llvm::Function *, Closure> closures;
+  // Closure values are a pair of a function and its environment, which hides what is called so the
+  // signature of the function (including the environment) is kept here
+  std::unordered_map<const llvm::Value *, llvm::FunctionType *> closure_signatures;
+  // Wrappers taking an ignored environment so functions without one can be closure values too
+  std::unordered_map<const llvm::Function *, llvm::Function *> closure_trampolines;
+
+  // Stack slots are allocated in the entry block and initialized where they are defined. Slots that
+  // escape the function are moved to the heap by allocating them at that definition instead
+  std::unordered_map<const llvm::AllocaInst *, llvm::Instruction *> allocation_sites;
+  // Lists that cannot outlive the constructor body creating them are allocated on the stack instead
+  // of the heap, as long as they are small enough. They are dead once that body ends, so unlike
+  // other slots they dont stop calls after it from reusing the frame
+  static constexpr uint64_t max_stack_list_size = 512;
+  std::set<const llvm::AllocaInst *> stack_lists;
+
+  // What calling functions can do besides returning, found from their bodies when they are defined
+  std::unordered_map<const llvm::Function *, FunctionEffects> function_effects;
+  // Every memoized function caches this many results, arguments that map to the same entry replace
+  // each others results
+  static constexpr unsigned int memo_table_bits = 12;
+  static constexpr uint64_t memo_table_size = uint64_t(1) << memo_table_bits;
+
+  // Calls of spawned tasks go through a function taking a frame holding the arguments and result
+  std::unordered_map<const llvm::Function *, llvm::Function *> task_functions;
+
+  // Functions with self recursive tail calls, these branch back to the header instead of calling
+  std::unordered_map<const llvm::Function *, TailRecursion> tail_recursions;
+
+  struct ArenaScope {
+    // Where the constructor body starts, null if it starts at the beginning of the block
+    llvm::BasicBlock *start_block;
+    llvm::Instruction *start_instruction;
+    // Blocks after this one were created inside the body
+    llvm::BasicBlock *last_block;
+    std::vector<llvm::CallInst *> list_allocations;
+    // Lists stored only in slots defined inside the body are unreachable once it ends
+    std::set<const llvm::AllocaInst *> slots;
+  };
+  // Constructor bodies being compiled, innermost last
+  std::vector<ArenaScope> arena_scopes;
+
+  llvm::OptimizationLevel optimization_level;
+  // Whether independent calls of pure functions run in parallel with each other
+  bool parallelize;
+
+  // Set if the compiler only generates part of the program. Top level functions are dealt round
+  // robin to the partitions, the ones of other partitions are only declared
+  struct Partition {
+    size_t index;
+    size_t count;
+    // Effects of every top level function resolved up front, if set the functions of other
+    // partitions can be declared without the functions they call
+    const std::unordered_map<std::string, FunctionEffects> *effects = nullptr;
+  };
+  std::optional<Partition> partition = std::nullopt;
+  size_t top_level_function_count = 0;
+  // Only set up when emitting native code, textual IR and bitcode are kept target independent
+  std::unique_ptr<llvm::TargetMachine> target_machine;
+
+  [[noreturn]] static void error(const std::string &message);
+
+  // Set up a target machine for the host and lower the module's triple and data layout for it
+  void initialize_target();
+  // Generate the module for `root` (or only some of its statements) and run the optimization
+  // pipeline over it
+  void build_module(const Parser::RootNode &root);
+  void build_module(const std::vector<const Parser::Statement *> &statements);
+  // Only generate the module, e.g. to declare the functions of a program without optimizing away
+  // the ones that are unused
+  void generate_module(const std::vector<const Parser::Statement *> &statements);
+  // Run the default new pass manager pipeline for `optimization_level` over the module
+  void optimize_module();
+  void emit_native(llvm::raw_pwrite_stream &stream, llvm::CodeGenFileType file_type);
+  void save_module(const std::string &path, OutputType output_type);
 
   /// Externally defined libc functions
   void declare_malloc();
   void declare_printf();
   void declare_extern_functions();
+  // `len` is a builtin function returning the length of a list
+  void define_len();
+  // Functions of the runtime library are declared when first used, they are not visible to programs
+  llvm::FunctionCallee get_runtime_function(const std::string &name, llvm::FunctionType *type);
 
   llvm::Value *int_to_float(llvm::Value *i);
 
   /// IRBuilder wrappers that fix alignment
+  llvm::AllocaInst *create_entry_alloca(llvm::Type *type, const std::string &name);
   llvm::AllocaInst *create_alloca(const std::string &name, llvm::Value *init, llvm::Type *type);
   llvm::AllocaInst *create_alloca(const std::string &name, const std::vector<llvm::Value *> &init,
                                   llvm::Type *type);
@@ -75,20 +195,90 @@ private:
 
   llvm::FunctionType *add_parameter(const llvm::FunctionType *function_type, llvm::Type *parameter);
 
-  llvm::Value *create_closure_argument(llvm::StructType *closure_type);
+  // Names of the bindings captured by `name`: the ones among `referenced_names` bound in the
+  // current scope plus whatever the closures it references capture
+  std::vector<std::string> find_captures(const std::string &name,
+                                         const std::set<std::string> &referenced_names);
+  bool has_closure_environment(const llvm::Function *function) const;
+  // Allocate and fill the environment of `function` where it is defined, it is bound in the scope
+  // under `env:<function name>` for everything that calls the function
+  void create_closure_environment(const llvm::Function *function);
+  llvm::Value *get_closure_environment(const llvm::Function *function) const;
+  llvm::Function *get_closure_trampoline(llvm::Function *function);
   void load_arguments(const llvm::Function *function,
                       const std::vector<std::unique_ptr<Parser::FunctionParameter>> &parameters);
 
+  // Read-only global holding `list`, null unless every element is a constant
+  llvm::Constant *create_constant_list(const std::vector<llvm::Value *> &list, llvm::Type *type);
+  // The length of a list followed by `length` elements
+  llvm::StructType *get_list_type(llvm::Type *element_type, uint64_t length);
+  // Information about lists of a declared type, e.g. the parameters of a function
+  std::optional<ListInfo> get_list_info(const Parser::Type &type);
+  // Abort the program when `index` is not within the length of `list`
+  void create_bounds_check(llvm::Value *list, llvm::Value *index);
+
+  // Visited values are paired with whether the pointers loaded from them are being looked at
+  using EscapeVisits = std::set<std::pair<const llvm::Value *, bool>>;
+  // Whether `pointer` may still be reachable after the function it belongs to returns. Calls to
+  // user defined functions are followed into the callee
+  bool escapes(const llvm::Value *pointer, EscapeVisits &visited) const;
+  // Whether pointers stored into `memory` may escape, either with the memory itself or by being
+  // loaded back out of it
+  bool stored_pointers_escape(const llvm::Value *memory, EscapeVisits &visited) const;
+  bool loaded_pointers_escape(const llvm::Value *memory, EscapeVisits &visited) const;
+  void move_escaping_slots_to_heap(llvm::Function *function);
+
+  // Whether the body of `scope` can be left before its end, e.g. by returning from a tail call
+  bool has_early_exit(const ArenaScope &scope) const;
+  // Whether `pointer` is unreachable once the body of `scope` (evaluating to `result`) ends
+  bool is_scope_local(const llvm::Value *pointer, const llvm::Value *result,
+                      const ArenaScope &scope, std::set<const llvm::Value *> &visited) const;
+  // Replace the heap allocation of a list with a slot in the entry block
+  void move_list_to_stack(llvm::CallInst *allocation);
+
   bool is_externally_defined(const llvm::Function *function) const;
   // Call an externally defined function that follows the C ABI
-  std::variant<llvm::CallInst *, ArgumentCountError>
+  std::variant<llvm::Value *, ArgumentCountError>
   create_extern_call(llvm::Function *function, const std::vector<llvm::Value *> &arguments);
+  // Shared implementation of `and` and `or`, the rhs is skipped if the lhs is `short_circuit_value`
+  std::variant<llvm::Value *, BinaryOperatorError>
+  create_short_circuit(llvm::Value *lhs, const std::function<llvm::Value *()> &compile_rhs,
+                       bool short_circuit_value, const std::string &operator_name);
+
   // Call a userdefined function that follows kebab function declaration style
-  std::variant<llvm::CallInst *, ArgumentCountError>
-  create_userdefined_call(llvm::Function *function, std::vector<llvm::Value *> &arguments);
+  std::variant<llvm::Value *, ArgumentCountError>
+  create_userdefined_call(llvm::Function *function, std::vector<llvm::Value *> &arguments,
+                          bool is_tail_call);
+  // Turn a call in tail position into a guaranteed tail call when the frame can be reused
+  llvm::Value *complete_call(llvm::CallInst *call, bool is_tail_call);
+
+  // Split the entry block of `function` so the rest can be looped over by recursive tail calls
+  TailRecursion &get_tail_recursion(llvm::Function *function);
+  llvm::Value *create_self_tail_call(llvm::Function *function,
+                                     const std::vector<llvm::Value *> &arguments);
+  // A tail call replaces the frame of the caller, so it cannot be used when the callee may be
+  // handed pointers into that frame
+  bool has_stack_slots(const llvm::Function *function) const;
+
+  // Resolve the calls of a function body named `name` with the effects of the functions they call
+  FunctionEffects resolve_effects(const std::string &name, const Effects &effects,
+                                  bool is_closure) const;
+  // Tell LLVM what calling `function` can do, so calls can be moved, merged or removed
+  void add_effect_attributes(llvm::Function *function, FunctionEffects effects);
+  // Wrap `function` in a function that only calls it for arguments missing from its cache. The
+  // wrapper is only declared if `function` is
+  llvm::Function *create_memoized_function(llvm::Function *function);
+  llvm::Function *get_task_function(llvm::Function *function, llvm::StructType *frame_type);
+  // Everything calls of the top level function `name` rely on, callers in other modules have to be
+  // generated again when it changes
+  std::string describe_declaration(const std::string &name) const;
 
 public:
-  Compiler() : mod("kebab", context), builder(context) {
+  explicit Compiler(llvm::OptimizationLevel optimization_level = llvm::OptimizationLevel::O0,
+                    bool parallelize = false)
+      : context(std::make_unique<llvm::LLVMContext>()),
+        mod(std::make_unique<llvm::Module>("kebab", *this->context)), builder(*this->context),
+        optimization_level(optimization_level), parallelize(parallelize) {
     this->primitive_types["int"] = this->builder.getInt64Ty();
     this->primitive_types["float"] = this->builder.getDoubleTy();
     this->primitive_types["char"] = this->builder.getInt8Ty();
@@ -97,7 +287,11 @@ public:
     this->primitive_types["void"] = this->builder.getVoidTy();
   }
 
-  void compile(std::unique_ptr<Parser::RootNode> root, const std::string &output_path);
+  void compile(std::unique_ptr<Parser::RootNode> root, const std::string &output_path,
+               OutputType output_type = OutputType::LLVM_IR);
+  // Compile `root` into a module for the JIT instead of writing it to a file. The module and its
+  // context are moved out of the compiler so it cannot be used to compile anything else afterwards
+  llvm::orc::ThreadSafeModule compile_for_jit(std::unique_ptr<Parser::RootNode> root);
 
   /// Type getters
   std::variant<llvm::Type *, UnrecognizedTypeError>
@@ -137,16 +331,21 @@ public:
   }
 
   llvm::Value *create_list(const std::vector<llvm::Value *> &list, llvm::Type *type);
+  // Pair `function` with its environment so it can be stored and called like any other value
+  llvm::Value *create_closure_value(llvm::Function *function);
 
   /// Constructors for more complicated instructions
-  llvm::StructType *create_closure_type();
-  llvm::Function *
+  llvm::StructType *create_closure_type(const std::vector<std::string> &captures);
+  // Memoized functions are returned (and bound) as the function looking up their cache
+  std::variant<llvm::Function *, MemoizationError>
   define_function(const llvm::FunctionType *function_type, const std::string &name,
                   const Parser::Constructor &body,
-                  const std::vector<std::unique_ptr<Parser::FunctionParameter>> &parameters);
+                  const std::vector<std::unique_ptr<Parser::FunctionParameter>> &parameters,
+                  const std::set<std::string> &referenced_names, const Effects &effects,
+                  bool is_memoized = false);
   llvm::Function *declare_function(llvm::FunctionType *type, const std::string &name);
 
-  std::variant<llvm::AllocaInst *, RedefinitionError>
+  std::variant<llvm::Value *, RedefinitionError>
   create_definition(const std::string &name, llvm::Value *init, bool is_mutable);
   std::variant<llvm::Value *, ImmutableAssignmentError, AssignNonExistingError, TypeError>
   create_assignment(const std::string &name, llvm::Value *init);
@@ -161,9 +360,29 @@ public:
              const std::vector<std::pair<llvm::Value *, llvm::BasicBlock *>> &incoming);
 
   // arguments is not const because the function may append the closure environment to the arguments
-  // before calling the function
-  std::variant<llvm::CallInst *, ArgumentCountError>
-  create_call(llvm::Function *function, std::vector<llvm::Value *> &arguments);
+  // before calling the function. Tail calls return from the current function themselves (or loop
+  // for self recursion) so nothing else can be added to the current block afterwards
+  std::variant<llvm::Value *, ArgumentCountError>
+  create_call(llvm::Function *function, std::vector<llvm::Value *> &arguments,
+              bool is_tail_call = false);
+  std::variant<llvm::Value *, ArgumentCountError>
+  create_closure_call(llvm::Value *closure, std::vector<llvm::Value *> &arguments,
+                      bool is_tail_call = false);
+
+  // A call running in parallel with the code after it, its result can be used once it is joined
+  struct Task {
+    llvm::Value *handle;
+    llvm::AllocaInst *frame;
+    llvm::StructType *frame_type;
+  };
+  // Only recursive pure functions are worth spawning, anything else is cheaper to call right away.
+  // Their results are handed back through memory so they have to be plain values
+  bool is_spawnable(const std::string &name) const;
+  // Tasks have to be joined in the reverse order of spawning, before the current function returns
+  std::variant<Task, ArgumentCountError> create_spawn(llvm::Function *function,
+                                                      const std::vector<llvm::Value *> &arguments);
+  llvm::Value *create_join(const Task &task);
+  llvm::ReturnInst *create_return(llvm::Value *value) { return this->builder.CreateRet(value); }
 
   /// Unary mathematical operators
   std::variant<llvm::Value *, UnaryOperatorError> create_neg(llvm::Value *v);
@@ -190,19 +409,40 @@ public:
   std::variant<llvm::Value *, BinaryOperatorError> create_ge(llvm::Value *lhs, llvm::Value *rhs);
 
   /// Binary logical operators
-  std::variant<llvm::Value *, BinaryOperatorError> create_and(llvm::Value *lhs, llvm::Value *rhs);
-  std::variant<llvm::Value *, BinaryOperatorError> create_or(llvm::Value *lhs, llvm::Value *rhs);
+  // These short circuit, `compile_rhs` is only called to generate code for the rhs in a branch that
+  // is taken when the lhs does not already decide the result
+  std::variant<llvm::Value *, BinaryOperatorError>
+  create_and(llvm::Value *lhs, const std::function<llvm::Value *()> &compile_rhs);
+  std::variant<llvm::Value *, BinaryOperatorError>
+  create_or(llvm::Value *lhs, const std::function<llvm::Value *()> &compile_rhs);
 
   /// Setter wrappers
   void set_insert_point(llvm::BasicBlock *block) { this->builder.SetInsertPoint(block); }
 
   /// Scope wrappers and lookups
   std::variant<llvm::Value *, NameError> get_value(const std::string &name);
+  // Null unless `value` is a closure value
+  llvm::FunctionType *get_closure_signature(const llvm::Value *value) const;
+  // Empty unless `list` is a list with a length known while compiling
+  std::optional<uint64_t> get_list_length(const llvm::Value *list) const;
+  // Only known for functions defined by the program (and builtins like `len`)
+  std::optional<FunctionEffects> get_function_effects(const llvm::Function *function) const;
 
   void start_scope() { this->current_scope = std::make_shared<Scope>(this->current_scope); }
 
   void end_scope() { this->current_scope = this->current_scope->parent_or(this->current_scope); }
 
+  // Scopes of constructor bodies, lists that cannot outlive the body are allocated in an arena that
+  // is freed all at once when the body (evaluating to `result`) ends
+  void start_constructor_scope();
+  void end_constructor_scope(llvm::Value *result);
+
+  llvm::BasicBlock *get_insert_block() const { return this->builder.GetInsertBlock(); }
+
+  bool is_block_terminated() const {
+    return this->builder.GetInsertBlock()->getTerminator() != nullptr;
+  }
+
   llvm::Function *get_current_function() const {
     return this->builder.GetInsertBlock()->getParent();
   }
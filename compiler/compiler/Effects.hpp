@@ -0,0 +1,56 @@
+#ifndef KEBAB_EFFECTS_HPP
+#define KEBAB_EFFECTS_HPP
+
+#include <algorithm>
+#include <set>
+#include <string>
+
+namespace Kebab {
+
+// What running some code can do besides producing its value, from least to most. Code has the
+// largest effect of anything it runs
+enum class Effect {
+  PURE,         // only depends on its arguments
+  READS_MEMORY, // also reads lists or state captured by a closure
+  SIDE_EFFECTS, // anything else, e.g. printing, allocating or assigning to outer variables
+};
+
+constexpr Effect combine_effects(Effect a, Effect b) { return std::max(a, b); }
+
+// Effects of a function body as far as they are known from the AST alone. Calls and assignments of
+// names bound outside the function are resolved by the compiler once those names are bound
+struct Effects {
+  Effect effect = Effect::PURE;
+  // Whether the body always returns, as long as every function it calls by name does too
+  bool always_returns = true;
+  std::set<std::string> called_names;
+  std::set<std::string> assigned_names;
+  // Names defined in the body. The bodies of local functions are part of the body already, other
+  // local names could be bound to any closure
+  std::set<std::string> local_names;
+  std::set<std::string> local_functions;
+
+  void add(Effect other) { this->effect = combine_effects(this->effect, other); }
+  // Calls of closures that are not known by name could be calls of anything
+  void add_unknown_call() {
+    this->add(Effect::SIDE_EFFECTS);
+    this->always_returns = false;
+  }
+  // Add the effects of a nested function, its local names are not visible here
+  void add(const Effects &other) {
+    this->add(other.effect);
+    this->always_returns = this->always_returns && other.always_returns;
+    this->called_names.insert(other.called_names.begin(), other.called_names.end());
+    this->assigned_names.insert(other.assigned_names.begin(), other.assigned_names.end());
+  }
+};
+
+// Effects of calling a compiled function
+struct FunctionEffects {
+  Effect effect;
+  bool always_returns;
+};
+
+} // namespace Kebab
+
+#endif
@@ -5,22 +5,23 @@
 
 #include "compiler/Errors.hpp"
 #include "compiler/Scope.hpp"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Type.h"
 #include "llvm/Support/Casting.h"
 
-std::optional<ArgumentCountError> ArgumentCountError::check(const llvm::Function *function,
-                                                            size_t argument_count) {
-  size_t function_arg_size = function->arg_size();
+std::optional<ArgumentCountError> ArgumentCountError::check(const llvm::FunctionType *type,
+                                                            size_t argument_count,
+                                                            bool has_closure_environment) {
+  // The closure is passed implicitly (user shouldn't see that it is an argument to their function)
+  size_t function_arg_size = type->getNumParams() - has_closure_environment;
 
-  if (function->isVarArg()) {
+  if (type->isVarArg()) {
     if (argument_count < function_arg_size)
-      // currently all variadic functions are extern meaning they dont take a closure so no -1
       return ArgumentCountError(function_arg_size, argument_count);
   } else {
     if (function_arg_size != argument_count)
-      // -1 for closure (user shouldn't see that this is an argument to their function)
-      return ArgumentCountError(function_arg_size - 1, argument_count - 1);
+      return ArgumentCountError(function_arg_size, argument_count);
   }
 
   return std::nullopt;
@@ -31,8 +32,9 @@ std::string ArgumentCountError::to_string() const {
                      std::to_string(this->expected), std::to_string(this->actual));
 }
 
-std::optional<UncallableError> UncallableError::check(const llvm::Value *callee) {
-  if (llvm::isa<llvm::Function>(callee))
+std::optional<UncallableError> UncallableError::check(const llvm::Value *callee,
+                                                      const llvm::FunctionType *closure_signature) {
+  if (llvm::isa<llvm::Function>(callee) || closure_signature != nullptr)
     return std::nullopt;
   else
     return UncallableError(callee);
@@ -60,15 +62,22 @@ std::string UnsubscriptableError::to_string() const {
                      type_string);
 }
 
-std::optional<IndexError> IndexError::check(const llvm::Value *subscriptee,
-                                            const llvm::Value *index) {
-  // TODO:
-  return std::nullopt;
+std::optional<IndexError> IndexError::check(const llvm::Value *index,
+                                            std::optional<uint64_t> length) {
+  const auto *constant = llvm::dyn_cast<llvm::ConstantInt>(index);
+  if (constant == nullptr || !length.has_value())
+    return std::nullopt;
+
+  // Negative indices are out of bounds as well, comparing them unsigned makes them huge
+  if (constant->getZExtValue() < length.value())
+    return std::nullopt;
+  else
+    return IndexError(constant->getSExtValue(), length.value());
 }
 
 std::string IndexError::to_string() const {
-  // TODO:
-  return std::format("index-error: index out of bounds");
+  return std::format("index-error: index {} is out of bounds for list of length {}", this->index,
+                     this->length);
 }
 
 std::optional<NonhomogenousListError> NonhomogenousListError::check(const llvm::Type *expected,
@@ -88,6 +97,30 @@ std::string NonhomogenousListError::to_string() const {
                      expected_string, actual_string);
 }
 
+std::optional<MemoizationError> MemoizationError::check(const llvm::FunctionType *type,
+                                                        Kebab::Effect effect) {
+  if (effect != Kebab::Effect::PURE)
+    return MemoizationError(nullptr);
+
+  // Pointers (strings, lists and closures) would be cached by their address
+  auto is_primitive = [](const llvm::Type *t) { return t->isIntegerTy() || t->isDoubleTy(); };
+  if (!is_primitive(type->getReturnType()))
+    return MemoizationError(type->getReturnType());
+  for (const llvm::Type *parameter : type->params())
+    if (!is_primitive(parameter))
+      return MemoizationError(parameter);
+
+  return std::nullopt;
+}
+
+std::string MemoizationError::to_string() const {
+  if (this->type == nullptr)
+    return "memoization-error: only pure functions can be memoized";
+
+  return std::format("memoization-error: functions taking or returning '{}' cannot be memoized",
+                     CompilerError::type_to_string(this->type));
+}
+
 std::optional<ImmutableAssignmentError>
 ImmutableAssignmentError::check(const Scope &scope, const std::string &assignee) {
   std::optional<Scope::Binding> maybe_binding = scope.lookup(assignee);
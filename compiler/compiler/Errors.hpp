@@ -2,11 +2,13 @@
 #define KEBAB_ERRORS_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <unordered_map>
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunused-parameter"
+#include "compiler/Effects.hpp"
 #include "compiler/Scope.hpp"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
@@ -36,8 +38,9 @@ private:
   ArgumentCountError(size_t expected, size_t actual) : expected(expected), actual(actual){};
 
 public:
-  static std::optional<ArgumentCountError> check(const llvm::Function *function,
-                                                 size_t argument_count);
+  static std::optional<ArgumentCountError> check(const llvm::FunctionType *type,
+                                                 size_t argument_count,
+                                                 bool has_closure_environment = false);
 
   std::string to_string() const final;
 };
@@ -49,7 +52,9 @@ private:
   explicit UncallableError(const llvm::Value *callee) : callee(callee) {}
 
 public:
-  static std::optional<UncallableError> check(const llvm::Value *callee);
+  // Functions can be called directly, closure values through their signature
+  static std::optional<UncallableError>
+  check(const llvm::Value *callee, const llvm::FunctionType *closure_signature = nullptr);
 
   std::string to_string() const final;
 };
@@ -68,14 +73,15 @@ public:
 
 class IndexError : public CompilerError {
 private:
-  const llvm::Value *list;
-  const llvm::Value *index;
+  int64_t index;
+  uint64_t length;
 
-  IndexError(const llvm::Value *subscriptee, const llvm::Value *index)
-      : list(subscriptee), index(index) {}
+  IndexError(int64_t index, uint64_t length) : index(index), length(length) {}
 
 public:
-  static std::optional<IndexError> check(const llvm::Value *subscriptee, const llvm::Value *index);
+  // Only indices known while compiling into lists with a known length can be checked here, the rest
+  // are checked when the program runs
+  static std::optional<IndexError> check(const llvm::Value *index, std::optional<uint64_t> length);
 
   std::string to_string() const final;
 };
@@ -175,6 +181,21 @@ public:
   std::string to_string() const final;
 };
 
+class MemoizationError : public CompilerError {
+private:
+  // The parameter or return type that cannot be cached, null if the function is not pure
+  const llvm::Type *type;
+
+  explicit MemoizationError(const llvm::Type *type) : type(type) {}
+
+public:
+  // Results are cached by the values of the arguments, so they cannot depend on anything else
+  static std::optional<MemoizationError> check(const llvm::FunctionType *type,
+                                               Kebab::Effect effect);
+
+  std::string to_string() const final;
+};
+
 class UnaryOperatorError : public CompilerError {
 private:
   const llvm::Type *type;
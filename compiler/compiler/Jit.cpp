@@ -0,0 +1,105 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "compiler/Jit.hpp"
+#include "runtime/Runtime.hpp"
+#include "llvm/ExecutionEngine/JITSymbol.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/Mangling.h"
+#include "llvm/Support/TargetSelect.h"
+
+namespace Kebab {
+
+Jit::Jit() {
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+
+  this->lljit = Jit::unwrap(llvm::orc::LLJITBuilder().create());
+}
+
+[[noreturn]] void Jit::error(llvm::Error error) {
+  std::cerr << "jit-error: " << llvm::toString(std::move(error)) << std::endl;
+
+  exit(1);
+}
+
+template <typename T> T Jit::unwrap(llvm::Expected<T> expected) {
+  if (!expected)
+    Jit::error(expected.takeError());
+
+  // References (e.g. `JITDylib &`) are returned as references while owned values are moved
+  return std::forward<T>(*expected);
+}
+
+llvm::orc::JITDylib &Jit::create_dylib() {
+  std::string name = "kebab-" + std::to_string(this->dylib_count++);
+  llvm::orc::JITDylib &dylib = Jit::unwrap(this->lljit->createJITDylib(name));
+
+  // Symbols that are not defined by the program itself (libc functions) are looked up in the
+  // process running the JIT
+  char global_prefix = this->lljit->getDataLayout().getGlobalPrefix();
+  dylib.addGenerator(Jit::unwrap(
+      llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(global_prefix)));
+  this->define_runtime(dylib);
+
+  return dylib;
+}
+
+void Jit::define_runtime(llvm::orc::JITDylib &dylib) {
+  llvm::orc::MangleAndInterner mangle(this->lljit->getExecutionSession(),
+                                      this->lljit->getDataLayout());
+  auto define = [](auto *function) {
+    return llvm::orc::ExecutorSymbolDef(llvm::orc::ExecutorAddr::fromPtr(function),
+                                        llvm::JITSymbolFlags::Exported |
+                                            llvm::JITSymbolFlags::Callable);
+  };
+
+  llvm::orc::SymbolMap symbols;
+  symbols[mangle("kebab_arena_push")] = define(&kebab_arena_push);
+  symbols[mangle("kebab_arena_pop")] = define(&kebab_arena_pop);
+  symbols[mangle("kebab_arena_alloc")] = define(&kebab_arena_alloc);
+  symbols[mangle("kebab_index_error")] = define(&kebab_index_error);
+  symbols[mangle("kebab_spawn")] = define(&kebab_spawn);
+  symbols[mangle("kebab_join")] = define(&kebab_join);
+
+  if (llvm::Error error = dylib.define(llvm::orc::absoluteSymbols(std::move(symbols))))
+    Jit::error(std::move(error));
+}
+
+int64_t Jit::run_main(llvm::orc::ThreadSafeModule module) {
+  std::vector<llvm::orc::ThreadSafeModule> modules;
+  modules.push_back(std::move(module));
+  return this->run_main(std::move(modules));
+}
+
+int64_t Jit::run_main(std::vector<llvm::orc::ThreadSafeModule> modules) {
+  llvm::orc::JITDylib &dylib = this->create_dylib();
+  for (llvm::orc::ThreadSafeModule &module : modules)
+    if (llvm::Error error = this->lljit->addIRModule(dylib, std::move(module)))
+      Jit::error(std::move(error));
+
+  return this->call_main(dylib);
+}
+
+int64_t Jit::run_main(std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects) {
+  llvm::orc::JITDylib &dylib = this->create_dylib();
+  for (std::unique_ptr<llvm::MemoryBuffer> &object : objects)
+    if (llvm::Error error = this->lljit->addObjectFile(dylib, std::move(object)))
+      Jit::error(std::move(error));
+
+  return this->call_main(dylib);
+}
+
+int64_t Jit::call_main(llvm::orc::JITDylib &dylib) {
+  // `main` is defined at the top level so it never captures anything and takes no environment
+  auto main_address = Jit::unwrap(this->lljit->lookup(dylib, "main"));
+  auto *main = main_address.toPtr<int64_t (*)()>();
+
+  return main();
+}
+
+} // namespace Kebab
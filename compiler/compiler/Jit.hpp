@@ -0,0 +1,48 @@
+#ifndef KEBAB_JIT_HPP
+#define KEBAB_JIT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#pragma clang diagnostic pop
+
+namespace Kebab {
+
+// In-process ORC JIT session. Every module added to the session gets its own JITDylib so several
+// programs (each with their own `main`) can be run by the same session one after another
+class Jit {
+private:
+  std::unique_ptr<llvm::orc::LLJIT> lljit;
+  size_t dylib_count = 0;
+
+  [[noreturn]] static void error(llvm::Error error);
+  template <typename T> static T unwrap(llvm::Expected<T> expected);
+
+  llvm::orc::JITDylib &create_dylib();
+  // The runtime is linked into the compiler, so programs in the JIT call the same functions
+  void define_runtime(llvm::orc::JITDylib &dylib);
+  int64_t call_main(llvm::orc::JITDylib &dylib);
+
+public:
+  Jit();
+
+  // Link `module` into the session, resolving externally defined functions like `printf` and
+  // `malloc` from the host process, and call its `main` function
+  int64_t run_main(llvm::orc::ThreadSafeModule module);
+  // Programs generated in partitions are linked together, one of the modules defines `main`
+  int64_t run_main(std::vector<llvm::orc::ThreadSafeModule> modules);
+  // Programs can also be linked from object files, e.g. ones that were cached
+  int64_t run_main(std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects);
+};
+
+} // namespace Kebab
+
+#endif
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "compiler/PartitionedCompiler.hpp"
+#include "lexer/Span.hpp"
+#include "parser/Constructor.hpp"
+#include "parser/RootNode.hpp"
+#include "parser/Statement.hpp"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/TargetParser/Host.h"
+
+namespace Kebab {
+
+// Bumped whenever the compiler generates different code for the same source, so entries cached by
+// older versions are not used
+static constexpr int cache_format_version = 1;
+
+// Null unless `statement` defines a function
+static const Parser::DefinitionStatement *get_function_definition(const Parser::Statement *statement) {
+  const auto *definition = dynamic_cast<const Parser::DefinitionStatement *>(statement);
+  if (definition == nullptr ||
+      dynamic_cast<const Parser::FunctionConstructor *>(definition->constructor.get()) == nullptr)
+    return nullptr;
+  return definition;
+}
+
+// The source of `node`, the lexer is always a token ahead so this is from right after its first
+// token up to the end of the token after it
+static std::string_view get_source(std::string_view source, const std::vector<size_t> &line_starts,
+                                   const Parser::AstNode &node) {
+  auto get_offset = [source, &line_starts](Position position) {
+    if (position.line == 0 || position.line > line_starts.size())
+      return source.size();
+    return std::min(line_starts[position.line - 1] + position.col, source.size());
+  };
+
+  size_t start = get_offset(node.get_span().start);
+  size_t end = get_offset(node.get_span().end);
+  return source.substr(start, std::max(start, end) - start);
+}
+
+PartitionedCompiler::PartitionedCompiler(llvm::OptimizationLevel optimization_level,
+                                         bool parallelize, size_t partition_count,
+                                         unsigned int jobs)
+    : optimization_level(optimization_level), parallelize(parallelize),
+      partition_count(partition_count > 0 ? partition_count : 1), jobs(jobs > 0 ? jobs : 1) {
+  // Targets register themselves globally, which is not safe to do from several threads at once
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+}
+
+void PartitionedCompiler::parallel_for(size_t count,
+                                       const std::function<void(size_t)> &task) const {
+  // Indices are handed out in order, whichever thread is free takes the next one
+  std::atomic<size_t> next = 0;
+  auto run_tasks = [&task, &next, count]() {
+    for (size_t index = next++; index < count; index = next++)
+      task(index);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < this->jobs && i < count; ++i)
+    threads.emplace_back(run_tasks);
+  run_tasks();
+
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+void PartitionedCompiler::for_each_partition(
+    const std::function<void(Compiler &, size_t)> &build) const {
+  this->parallel_for(this->partition_count, [this, &build](size_t index) {
+    Compiler compiler(this->optimization_level, this->parallelize);
+    compiler.partition = Compiler::Partition{index, this->partition_count};
+    build(compiler, index);
+  });
+}
+
+void PartitionedCompiler::compile(std::unique_ptr<Parser::RootNode> root,
+                                  const std::string &output_path,
+                                  Compiler::OutputType output_type) {
+  bool is_native = output_type == Compiler::OutputType::OBJECT ||
+                   output_type == Compiler::OutputType::ASSEMBLY;
+
+  this->for_each_partition([&root, &output_path, output_type, is_native](Compiler &compiler,
+                                                                          size_t index) {
+    if (is_native)
+      compiler.initialize_target();
+
+    compiler.build_module(*root);
+    compiler.save_module(PartitionedCompiler::get_partition_path(output_path, index), output_type);
+  });
+}
+
+std::vector<llvm::orc::ThreadSafeModule>
+PartitionedCompiler::compile_for_jit(std::unique_ptr<Parser::RootNode> root) {
+  std::vector<llvm::orc::ThreadSafeModule> modules(this->partition_count);
+
+  this->for_each_partition([&root, &modules](Compiler &compiler, size_t index) {
+    compiler.initialize_target();
+    compiler.build_module(*root);
+    modules[index] =
+        llvm::orc::ThreadSafeModule(std::move(compiler.mod), std::move(compiler.context));
+  });
+
+  return modules;
+}
+
+std::vector<std::unique_ptr<llvm::MemoryBuffer>>
+PartitionedCompiler::build_cached(const Parser::RootNode &root, CompilationCache &cache) const {
+  std::ifstream stream(root.get_path());
+  std::stringstream contents;
+  contents << stream.rdbuf();
+  std::string source = contents.str();
+  std::vector<size_t> line_starts = {0};
+  for (size_t i = 0; i < source.size(); ++i)
+    if (source[i] == '\n')
+      line_starts.push_back(i + 1);
+
+  // Statements other than function definitions are part of every module
+  std::vector<const Parser::Statement *> statements;
+  std::vector<const Parser::DefinitionStatement *> functions;
+  std::unordered_map<std::string, size_t> function_indices;
+  std::set<std::string> shared_names;
+  std::string shared_source;
+  for (const std::unique_ptr<Parser::Statement> &statement : root.statements) {
+    statements.push_back(statement.get());
+    if (const auto *function = get_function_definition(statement.get()); function != nullptr) {
+      function_indices[function->name] = functions.size();
+      functions.push_back(function);
+    } else {
+      statement->collect_referenced_names(shared_names);
+      shared_source += get_source(source, line_starts, *statement);
+    }
+  }
+
+  // Declaring every function once resolves the effects of all of them, so the modules of the
+  // functions only have to declare the ones they refer to. An index past the last partition
+  // defines none of them
+  size_t function_count = std::max<size_t>(functions.size(), 1);
+  Compiler declarations(this->optimization_level, this->parallelize);
+  declarations.partition = Compiler::Partition{function_count, function_count};
+  declarations.generate_module(statements);
+
+  std::unordered_map<std::string, FunctionEffects> effects;
+  std::unordered_map<std::string, std::string> descriptions;
+  for (const Parser::DefinitionStatement *function : functions) {
+    effects[function->name] =
+        declarations.function_effects.at(declarations.mod->getFunction(function->name));
+    descriptions[function->name] = declarations.describe_declaration(function->name);
+  }
+
+  std::string options = std::format(
+      "kebab-cache {} O{}s{} {} {}\n", cache_format_version,
+      this->optimization_level.getSpeedupLevel(), this->optimization_level.getSizeLevel(),
+      this->parallelize ? "parallel" : "sequential", llvm::sys::getDefaultTargetTriple());
+
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects(functions.size());
+  this->parallel_for(functions.size(), [&](size_t index) {
+    const Parser::DefinitionStatement &function = *functions[index];
+    std::set<std::string> names = shared_names;
+    function.collect_referenced_names(names);
+    names.insert(function.name);
+
+    // Functions defined after this one are not visible to it
+    std::string key = options + shared_source + std::string(get_source(source, line_starts, function));
+    for (const std::string &name : names)
+      if (auto it = function_indices.find(name); it != function_indices.end() && it->second != index)
+        key += (it->second < index ? "before " : "after ") + descriptions.at(name);
+
+    objects[index] = cache.load(key);
+    if (objects[index] != nullptr)
+      return;
+
+    // Only the functions this one refers to are declared, it is the only function defined
+    std::vector<const Parser::Statement *> included;
+    size_t partition_index = 0;
+    size_t partition_count = 0;
+    for (const Parser::Statement *statement : statements) {
+      if (const auto *other = get_function_definition(statement); other != nullptr) {
+        if (!names.contains(other->name))
+          continue;
+        if (other == &function)
+          partition_index = partition_count;
+        ++partition_count;
+      }
+      included.push_back(statement);
+    }
+
+    Compiler compiler(this->optimization_level, this->parallelize);
+    compiler.partition = Compiler::Partition{partition_index, partition_count, &effects};
+    compiler.initialize_target();
+    compiler.build_module(included);
+
+    llvm::SmallVector<char, 0> object;
+    llvm::raw_svector_ostream object_stream(object);
+    compiler.emit_native(object_stream, llvm::CodeGenFileType::ObjectFile);
+    cache.store(key, object_stream.str());
+    objects[index] = llvm::MemoryBuffer::getMemBufferCopy(object_stream.str(), function.name);
+  });
+
+  return objects;
+}
+
+void PartitionedCompiler::compile_cached(std::unique_ptr<Parser::RootNode> root,
+                                         const std::string &output_path,
+                                         CompilationCache &cache) {
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects = this->build_cached(*root, cache);
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    std::string path = PartitionedCompiler::get_partition_path(output_path, i);
+    std::error_code error_code;
+    llvm::raw_fd_ostream stream(path, error_code);
+    if (error_code)
+      Compiler::error("could not open output file " + path + ": " + error_code.message());
+
+    stream << objects[i]->getBuffer();
+  }
+}
+
+std::vector<std::unique_ptr<llvm::MemoryBuffer>>
+PartitionedCompiler::compile_cached_for_jit(std::unique_ptr<Parser::RootNode> root,
+                                            CompilationCache &cache) {
+  return this->build_cached(*root, cache);
+}
+
+std::string PartitionedCompiler::get_partition_path(const std::string &path, size_t index) {
+  std::filesystem::path partition_path(path);
+  partition_path.replace_extension(std::to_string(index) +
+                                   std::filesystem::path(path).extension().string());
+  return partition_path.string();
+}
+
+} // namespace Kebab
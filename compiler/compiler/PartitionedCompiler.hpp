@@ -0,0 +1,62 @@
+#ifndef KEBAB_PARTITIONEDCOMPILER_HPP
+#define KEBAB_PARTITIONEDCOMPILER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/Passes/OptimizationLevel.h"
+#include "llvm/Support/MemoryBuffer.h"
+#pragma clang diagnostic pop
+
+#include "compiler/CompilationCache.hpp"
+#include "compiler/Compiler.hpp"
+
+namespace Kebab {
+
+// Generates a program as several modules, each with its own compiler (and context) so they can be
+// generated and optimized in parallel. Top level functions are dealt round robin to the partitions,
+// the modules only depend on how many partitions there are and not on how many threads build them
+class PartitionedCompiler {
+private:
+  llvm::OptimizationLevel optimization_level;
+  bool parallelize;
+  size_t partition_count;
+  unsigned int jobs;
+
+  // Call `task` with every index below `count`, on up to `jobs` threads at a time
+  void parallel_for(size_t count, const std::function<void(size_t)> &task) const;
+  // Call `build` with the compiler of every partition
+  void for_each_partition(const std::function<void(Compiler &, size_t)> &build) const;
+  // Object code of every top level function, in the order they are defined in
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> build_cached(const Parser::RootNode &root,
+                                                                CompilationCache &cache) const;
+
+public:
+  PartitionedCompiler(llvm::OptimizationLevel optimization_level, bool parallelize,
+                      size_t partition_count, unsigned int jobs);
+
+  // Every partition is saved to its own file, e.g. `out.o` becomes `out.0.o`, `out.1.o`, ...
+  void compile(std::unique_ptr<Parser::RootNode> root, const std::string &output_path,
+               Compiler::OutputType output_type = Compiler::OutputType::LLVM_IR);
+  std::vector<llvm::orc::ThreadSafeModule> compile_for_jit(std::unique_ptr<Parser::RootNode> root);
+  // Every top level function gets an object file of its own (instead of being dealt to partitions),
+  // only the ones that changed since they were cached are generated again. A function is only
+  // generated with the functions it refers to declared, so its key is its source, the source of
+  // other top level statements and what calls of those functions rely on
+  void compile_cached(std::unique_ptr<Parser::RootNode> root, const std::string &output_path,
+                      CompilationCache &cache);
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>>
+  compile_cached_for_jit(std::unique_ptr<Parser::RootNode> root, CompilationCache &cache);
+
+  static std::string get_partition_path(const std::string &path, size_t index);
+};
+
+} // namespace Kebab
+
+#endif
@@ -30,6 +30,15 @@ void Scope::put(const std::string &key, llvm::Value *value, llvm::Type *type, bo
   this->map.push_back({key, Binding{is_mutable, value, type}});
 }
 
+void Scope::replace(const llvm::Value *from, llvm::Value *to) {
+  for (auto &[k, b] : this->map)
+    if (b.value == from)
+      b.value = to;
+
+  if (this->parent.has_value())
+    this->parent.value()->replace(from, to);
+}
+
 std::vector<std::pair<const std::string &, Scope::Binding>> Scope::bindings() const {
   std::vector<std::pair<const std::string &, Binding>> local_bindings;
   std::set<std::string> seen;
@@ -16,6 +16,7 @@ class Scope {
 public:
   struct Binding {
     bool is_mutable;
+    // Mutable bindings point to the stack slot holding their value, immutable ones are the value
     llvm::Value *value;
     llvm::Type *type;
   };
@@ -29,6 +30,8 @@ public:
 
   std::optional<Binding> lookup(const std::string &key) const;
   void put(const std::string &key, llvm::Value *value, llvm::Type *type, bool is_mutable = false);
+  // Rebind every binding to `from` in this scope and its parents to `to`
+  void replace(const llvm::Value *from, llvm::Value *to);
 
   std::vector<std::pair<const std::string &, Binding>> bindings() const;
 
@@ -73,6 +73,8 @@ std::string Token::type_to_string(Type type) {
     return "set";
   case MUT:
     return "mut";
+  case MEMO:
+    return "memo";
   case NIL:
     return "nil";
   case IF:
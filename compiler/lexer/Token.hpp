@@ -18,6 +18,7 @@ public:
     DEF,  // def
     SET,  // set
     MUT,  // mut
+    MEMO, // memo
     NIL,  // nil
     IF,   // if
     ELIF, // elif
@@ -96,6 +97,8 @@ private:
       return SET;
     else if (word == "mut")
       return MUT;
+    else if (word == "memo")
+      return MEMO;
     else if (word == "if")
       return IF;
     else if (word == "elif")
@@ -1,29 +1,242 @@
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "compiler/CompilationCache.hpp"
 #include "compiler/Compiler.hpp"
+#include "compiler/Jit.hpp"
+#include "compiler/PartitionedCompiler.hpp"
 #include "lexer/Lexer.hpp"
 #include "logging/Logger.hpp"
 #include "parser/RootNode.hpp"
 
 using namespace Kebab;
 
-int main(int argc, char **argv) {
-  if (argc < 2) {
-    std::cerr << "Usage: " << argv[0] << " <file.keb> <args>" << std::endl;
-    return 1;
+static std::optional<llvm::OptimizationLevel> parse_optimization_level(const std::string &flag) {
+  if (flag == "-O0")
+    return llvm::OptimizationLevel::O0;
+  else if (flag == "-O1")
+    return llvm::OptimizationLevel::O1;
+  else if (flag == "-O2")
+    return llvm::OptimizationLevel::O2;
+  else if (flag == "-O3")
+    return llvm::OptimizationLevel::O3;
+  else
+    return std::nullopt;
+}
+
+static std::optional<Compiler::OutputType> parse_output_type(const std::string &flag) {
+  if (flag == "--emit=ll")
+    return Compiler::OutputType::LLVM_IR;
+  else if (flag == "--emit=bc")
+    return Compiler::OutputType::BITCODE;
+  else if (flag == "--emit=obj")
+    return Compiler::OutputType::OBJECT;
+  else if (flag == "--emit=asm")
+    return Compiler::OutputType::ASSEMBLY;
+  else
+    return std::nullopt;
+}
+
+// The number in flags like `--partitions=4`, empty unless it is a positive number
+static std::optional<size_t> parse_count(const std::string &flag, const std::string &name) {
+  if (!flag.starts_with(name + "="))
+    return std::nullopt;
+
+  size_t count = 0;
+  for (char digit : flag.substr(name.size() + 1)) {
+    if (digit < '0' || digit > '9')
+      return std::nullopt;
+    count = count * 10 + (digit - '0');
   }
 
-  std::string path(argv[1]);
+  if (count == 0)
+    return std::nullopt;
+  return count;
+}
 
-  Logger::silence();
+// The directory in `--cache=<dir>`
+static std::optional<std::string> parse_cache_directory(const std::string &flag) {
+  if (!flag.starts_with("--cache=") || flag.size() == std::string("--cache=").size())
+    return std::nullopt;
+  return flag.substr(std::string("--cache=").size());
+}
+
+static void print_cache_statistics(const CompilationCache &cache) {
+  std::cerr << "cache: " << cache.get_hits() << " hits, " << cache.get_misses() << " misses"
+            << std::endl;
+}
+
+static std::string default_output_path(Compiler::OutputType output_type) {
+  switch (output_type) {
+    using enum Compiler::OutputType;
+  case LLVM_IR:
+    return "out.ll";
+  case BITCODE:
+    return "out.bc";
+  case OBJECT:
+    return "out.o";
+  case ASSEMBLY:
+    return "out.s";
+  }
+}
+
+static int usage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " [-O0|-O1|-O2|-O3] [--parallel] [--partitions=<n>] [--jobs=<n>]"
+            << " [--emit=ll|bc|obj|asm] [-o <output>] <file.keb>\n"
+            << "       " << program
+            << " --emit=obj --cache=<dir> [--cache-stats] [-O0|-O1|-O2|-O3] [--parallel]"
+            << " [--jobs=<n>] [-o <output>] <file.keb>\n"
+            << "       " << program
+            << " run [-O0|-O1|-O2|-O3] [--parallel] [--partitions=<n>|--cache=<dir>]"
+            << " [--cache-stats] [--jobs=<n>] [--reuse-session] <file.keb>..." << std::endl;
+  return 1;
+}
 
+static std::unique_ptr<Parser::RootNode> parse_file(const std::string &path) {
   Lexer lexer(path);
-  std::unique_ptr<Parser::RootNode> root = Parser::RootNode::parse(lexer);
+  return Parser::RootNode::parse(lexer);
+}
+
+// `kebab run` - compile each file and run its `main` function in process, the exit code is the
+// return value of the first `main` that did not return 0
+static int run(int argc, char **argv) {
+  std::vector<std::string> paths;
+  llvm::OptimizationLevel optimization_level = llvm::OptimizationLevel::O0;
+  bool parallelize = false;
+  std::optional<size_t> partitions;
+  unsigned int jobs = std::thread::hardware_concurrency();
+  std::optional<std::string> cache_directory;
+  bool print_cache_stats = false;
+  bool reuse_session = false;
+
+  for (int i = 2; i < argc; ++i) {
+    std::string arg(argv[i]);
+
+    if (auto level = parse_optimization_level(arg); level.has_value())
+      optimization_level = level.value();
+    else if (arg == "--parallel")
+      parallelize = true;
+    else if (auto count = parse_count(arg, "--partitions"); count.has_value())
+      partitions = count.value();
+    else if (auto count = parse_count(arg, "--jobs"); count.has_value())
+      jobs = count.value();
+    else if (auto directory = parse_cache_directory(arg); directory.has_value())
+      cache_directory = directory;
+    else if (arg == "--cache-stats")
+      print_cache_stats = true;
+    else if (arg == "--reuse-session")
+      reuse_session = true;
+    else if (arg.starts_with('-'))
+      return usage(argv[0]);
+    else
+      paths.push_back(arg);
+  }
+
+  if (paths.empty() || (partitions.has_value() && cache_directory.has_value()))
+    return usage(argv[0]);
+
+  Logger::silence();
+
+  std::unique_ptr<CompilationCache> cache;
+  if (cache_directory.has_value())
+    cache = std::make_unique<CompilationCache>(cache_directory.value());
+
+  // Setting up a JIT session is fairly expensive so optionally share one between all the files
+  std::unique_ptr<Jit> jit;
+  int exit_code = 0;
+  for (const std::string &path : paths) {
+    if (jit == nullptr || !reuse_session)
+      jit = std::make_unique<Jit>();
+
+    int64_t result;
+    if (cache != nullptr) {
+      PartitionedCompiler compiler(optimization_level, parallelize, 1, jobs);
+      result = jit->run_main(compiler.compile_cached_for_jit(parse_file(path), *cache));
+    } else if (partitions.has_value()) {
+      PartitionedCompiler compiler(optimization_level, parallelize, partitions.value(), jobs);
+      result = jit->run_main(compiler.compile_for_jit(parse_file(path)));
+    } else {
+      Compiler compiler(optimization_level, parallelize);
+      result = jit->run_main(compiler.compile_for_jit(parse_file(path)));
+    }
+    if (result != 0) {
+      exit_code = static_cast<int>(result);
+      break;
+    }
+  }
+
+  if (cache != nullptr && print_cache_stats)
+    print_cache_statistics(*cache);
+  return exit_code;
+}
 
-  Compiler compiler;
-  compiler.compile(std::move(root), "out.ll");
+int main(int argc, char **argv) {
+  if (argc > 1 && std::string(argv[1]) == "run")
+    return run(argc, argv);
+
+  std::optional<std::string> path;
+  std::optional<std::string> output_path;
+  llvm::OptimizationLevel optimization_level = llvm::OptimizationLevel::O0;
+  Compiler::OutputType output_type = Compiler::OutputType::LLVM_IR;
+  bool parallelize = false;
+  std::optional<size_t> partitions;
+  unsigned int jobs = std::thread::hardware_concurrency();
+  std::optional<std::string> cache_directory;
+  bool print_cache_stats = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+
+    if (auto level = parse_optimization_level(arg); level.has_value())
+      optimization_level = level.value();
+    else if (auto type = parse_output_type(arg); type.has_value())
+      output_type = type.value();
+    else if (arg == "--parallel")
+      parallelize = true;
+    else if (auto count = parse_count(arg, "--partitions"); count.has_value())
+      partitions = count.value();
+    else if (auto count = parse_count(arg, "--jobs"); count.has_value())
+      jobs = count.value();
+    else if (auto directory = parse_cache_directory(arg); directory.has_value())
+      cache_directory = directory;
+    else if (arg == "--cache-stats")
+      print_cache_stats = true;
+    else if (arg == "-o" && i + 1 < argc)
+      output_path = argv[++i];
+    else if (arg.starts_with('-') || path.has_value())
+      return usage(argv[0]);
+    else
+      path = arg;
+  }
+
+  // Only object code is cached
+  if (!path.has_value() ||
+      (cache_directory.has_value() &&
+       (output_type != Compiler::OutputType::OBJECT || partitions.has_value())))
+    return usage(argv[0]);
+
+  Logger::silence();
+
+  std::string output = output_path.value_or(default_output_path(output_type));
+  if (cache_directory.has_value()) {
+    CompilationCache cache(cache_directory.value());
+    PartitionedCompiler compiler(optimization_level, parallelize, 1, jobs);
+    compiler.compile_cached(parse_file(path.value()), output, cache);
+    if (print_cache_stats)
+      print_cache_statistics(cache);
+  } else if (partitions.has_value()) {
+    PartitionedCompiler compiler(optimization_level, parallelize, partitions.value(), jobs);
+    compiler.compile(parse_file(path.value()), output, output_type);
+  } else {
+    Compiler compiler(optimization_level, parallelize);
+    compiler.compile(parse_file(path.value()), output, output_type);
+  }
 
   return 0;
 }
@@ -30,8 +30,10 @@ llvm::Value *AndTest::compile(Compiler &compiler) const {
   llvm::Value *result = this->not_tests.front()->compile(compiler);
 
   for (size_t i = 1; i < this->not_tests.size(); ++i) {
-    llvm::Value *rhs = this->not_tests[i]->compile(compiler);
-    std::variant<llvm::Value *, BinaryOperatorError> operation = compiler.create_and(result, rhs);
+    // Only evaluate the rhs if all the previous not tests were true
+    auto compile_rhs = [this, &compiler, i]() { return this->not_tests[i]->compile(compiler); };
+    std::variant<llvm::Value *, BinaryOperatorError> operation =
+        compiler.create_and(result, compile_rhs);
     if (std::holds_alternative<llvm::Value *>(operation))
       result = std::get<llvm::Value *>(operation);
     else
@@ -41,4 +43,19 @@ llvm::Value *AndTest::compile(Compiler &compiler) const {
   return result;
 }
 
+void AndTest::mark_tail_position() {
+  if (this->not_tests.size() == 1)
+    this->not_tests.front()->mark_tail_position();
+}
+
+void AndTest::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<NotTest> &not_test : this->not_tests)
+    not_test->collect_referenced_names(names);
+}
+
+void AndTest::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<NotTest> &not_test : this->not_tests)
+    not_test->collect_effects(effects);
+}
+
 } // namespace Kebab::Parser
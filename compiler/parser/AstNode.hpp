@@ -2,9 +2,11 @@
 #define KEBAB_PARSER_HPP
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include "compiler/Compiler.hpp"
+#include "compiler/Effects.hpp"
 #include "compiler/Errors.hpp"
 #include "lexer/Lexer.hpp"
 #include "llvm/IR/Value.h"
@@ -34,7 +36,18 @@ public:
   virtual ~AstNode() = default;
 
   static std::unique_ptr<AstNode> parse(Lexer &lexer);
+  const Span &get_span() const { return this->span; }
+  const std::string &get_path() const { return this->path; }
   virtual llvm::Value *compile(Compiler &compiler) const = 0;
+  // Called on nodes whose value is returned from the enclosing function, nodes that can end in a
+  // call pass this on so that call can be compiled as a tail call
+  virtual void mark_tail_position() {}
+  // Add every name this node (or any node nested in it) refers to, used to find what a function
+  // needs to capture from its enclosing scope
+  virtual void collect_referenced_names([[maybe_unused]] std::set<std::string> &names) const {}
+  // Add the effects of this node (and any node nested in it), used to find what calling a function
+  // can do besides returning its value
+  virtual void collect_effects([[maybe_unused]] Effects &effects) const {}
 };
 
 } // namespace Kebab::Parser
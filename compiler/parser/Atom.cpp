@@ -6,6 +6,7 @@
 #include "parser/Expression.hpp"
 #include "parser/Statement.hpp"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Value.h"
 
@@ -95,6 +96,10 @@ llvm::Value *NameAtom::compile(Compiler &compiler) const {
     this->compiler_error(std::get<NameError>(value));
 }
 
+void NameAtom::collect_referenced_names(std::set<std::string> &names) const {
+  names.insert(this->name);
+}
+
 std::unique_ptr<InnerExpressionAtom> InnerExpressionAtom::parse(Lexer &lexer) {
   auto atom = std::make_unique<InnerExpressionAtom>();
   atom->start_parsing(lexer, "<inner-expression-atom>");
@@ -111,6 +116,16 @@ llvm::Value *InnerExpressionAtom::compile(Compiler &compiler) const {
   return this->expression->compile(compiler);
 }
 
+void InnerExpressionAtom::mark_tail_position() { this->expression->mark_tail_position(); }
+
+void InnerExpressionAtom::collect_referenced_names(std::set<std::string> &names) const {
+  this->expression->collect_referenced_names(names);
+}
+
+void InnerExpressionAtom::collect_effects(Effects &effects) const {
+  this->expression->collect_effects(effects);
+}
+
 std::unique_ptr<ListAtom> ListAtom::parse(Lexer &lexer) {
   auto atom = std::make_unique<ListAtom>();
   atom->start_parsing(lexer, "<list-atom>");
@@ -129,24 +144,51 @@ std::unique_ptr<ListAtom> ListAtom::parse(Lexer &lexer) {
 }
 
 llvm::Value *ListAtom::compile(Compiler &compiler) const {
+  // Functions are stored as closure values so they can be called without knowing which one it is
   std::vector<llvm::Value *> elements_compiled;
-  for (const std::unique_ptr<Expression> &element : this->list)
-    elements_compiled.push_back(element->compile(compiler));
+  for (const std::unique_ptr<Expression> &element : this->list) {
+    llvm::Value *element_compiled = element->compile(compiler);
+    if (auto *function = llvm::dyn_cast<llvm::Function>(element_compiled); function != nullptr)
+      element_compiled = compiler.create_closure_value(function);
+
+    elements_compiled.push_back(element_compiled);
+  }
+
+  // Type check that the list is homogenous. Closure values all have the same type no matter what
+  // they call, so their signatures are compared instead
+  auto element_type = [&compiler](const llvm::Value *v) -> const llvm::Type * {
+    const llvm::FunctionType *signature = compiler.get_closure_signature(v);
+    return signature != nullptr ? signature : v->getType();
+  };
 
-  // Type check that the list is homogenous
   llvm::Type *expected_type = elements_compiled.front()->getType();
-  std::ranges::for_each(elements_compiled, [this, expected_type](const llvm::Value *v) {
-    const llvm::Type *actual_type = v->getType();
+  const llvm::Type *expected_element_type = element_type(elements_compiled.front());
+  std::ranges::for_each(elements_compiled, [this, &element_type,
+                                            expected_element_type](const llvm::Value *v) {
+    const llvm::Type *actual_type = element_type(v);
     // This could just be a typeerror as well, but that would generate slightly misleading error
     // messages since we're not really comparing the types with the expected type, only ensuring
     // that the list literal is homogenous
-    if (auto error = NonhomogenousListError::check(expected_type, actual_type); error.has_value())
+    if (auto error = NonhomogenousListError::check(expected_element_type, actual_type);
+        error.has_value())
       this->compiler_error(error.value());
   });
 
   return compiler.create_list(elements_compiled, expected_type);
 }
 
+void ListAtom::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Expression> &element : this->list)
+    element->collect_referenced_names(names);
+}
+
+void ListAtom::collect_effects(Effects &effects) const {
+  // Lists are allocated and written to when they are created
+  effects.add(Effect::SIDE_EFFECTS);
+  for (const std::unique_ptr<Expression> &element : this->list)
+    element->collect_effects(effects);
+}
+
 std::unique_ptr<Atom> Atom::parse(Lexer &lexer) {
   std::unique_ptr<Atom> atom;
 
@@ -66,6 +66,7 @@ public:
 
   static std::unique_ptr<NameAtom> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
 };
 
 class InnerExpressionAtom : public Atom {
@@ -74,6 +75,9 @@ public:
 
   static std::unique_ptr<InnerExpressionAtom> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 class ListAtom : public Atom {
@@ -82,6 +86,8 @@ public:
 
   static std::unique_ptr<ListAtom> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 } // namespace Kebab::Parser
@@ -115,4 +115,19 @@ llvm::Value *Comparison::compile(Compiler &compiler) const {
   return result;
 }
 
+void Comparison::mark_tail_position() {
+  if (this->terms.size() == 1)
+    this->terms.front()->mark_tail_position();
+}
+
+void Comparison::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Term> &term : this->terms)
+    term->collect_referenced_names(names);
+}
+
+void Comparison::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<Term> &term : this->terms)
+    term->collect_effects(effects);
+}
+
 } // namespace Kebab::Parser
@@ -71,6 +71,9 @@ public:
 
   static std::unique_ptr<Comparison> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 } // namespace Kebab::Parser
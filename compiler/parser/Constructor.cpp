@@ -1,5 +1,8 @@
 #include <cassert>
 #include <memory>
+#include <set>
+#include <string>
+#include <variant>
 #include <vector>
 
 #include "lexer/Lexer.hpp"
@@ -65,17 +68,29 @@ std::unique_ptr<ListConstructor> ListConstructor::parse(Lexer &lexer) {
 }
 
 llvm::Value *ListConstructor::compile(Compiler &compiler) const {
-  compiler.start_scope();
+  compiler.start_constructor_scope();
   for (size_t i = 0; i < this->body.size() - 1; ++i)
     this->body[i]->compile(compiler);
 
   // Return value of each constructor is the last statement (which is an expression)
   llvm::Value *return_value = this->body.back()->compile(compiler);
-  compiler.end_scope();
+  compiler.end_constructor_scope(return_value);
 
   return return_value;
 }
 
+void ListConstructor::mark_tail_position() { this->body.back()->mark_tail_position(); }
+
+void ListConstructor::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Statement> &statement : this->body)
+    statement->collect_referenced_names(names);
+}
+
+void ListConstructor::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<Statement> &statement : this->body)
+    statement->collect_effects(effects);
+}
+
 std::unique_ptr<FunctionParameter> FunctionParameter::parse(Lexer &lexer) {
   auto parameter = std::make_unique<FunctionParameter>();
   parameter->start_parsing(lexer, "<function-parameter>");
@@ -115,11 +130,40 @@ void FunctionConstructor::parse_type(Lexer &lexer) {
 void FunctionConstructor::parse_body(Lexer &lexer) {
   lexer.skip({Token::Type::FAT_RARROW});
   this->body = Constructor::parse(lexer);
+  // The value of the body is what the function returns
+  this->body->mark_tail_position();
+  this->body->collect_referenced_names(this->referenced_names);
+  for (const std::unique_ptr<FunctionParameter> &parameter : this->parameters)
+    this->referenced_names.erase(parameter->name);
+  this->body->collect_effects(this->effects);
+  this->resolve_local_effects();
   this->type->return_type = body->get_type();
 
   lexer.skip({Token::Type::RPAREN});
 }
 
+void FunctionConstructor::resolve_local_effects() {
+  // Parameters can be bound to any closure just like local names
+  for (const std::unique_ptr<FunctionParameter> &parameter : this->parameters)
+    this->effects.local_names.insert(parameter->name);
+
+  std::erase_if(this->effects.called_names, [this](const std::string &name) {
+    // Local functions could be recursive
+    if (this->effects.local_functions.contains(name))
+      this->effects.always_returns = false;
+    else if (this->effects.local_names.contains(name))
+      this->effects.add_unknown_call();
+    else
+      return false;
+
+    return true;
+  });
+  std::erase_if(this->effects.assigned_names, [this](const std::string &name) {
+    return this->effects.local_names.contains(name) ||
+           this->effects.local_functions.contains(name);
+  });
+}
+
 std::unique_ptr<FunctionConstructor> FunctionConstructor::parse(Lexer &lexer) {
   auto constructor = std::make_unique<FunctionConstructor>();
   constructor->start_parsing(lexer, "<function-constructor>");
@@ -137,13 +181,28 @@ std::unique_ptr<FunctionConstructor> FunctionConstructor::parse(Lexer &lexer) {
 llvm::Value *FunctionConstructor::compile(Compiler &compiler) const {
   // NOTE: parameters of function are inferred by the prototype, however we still have to set their
   // names which is done by calling FunctionParameter::compile inside the define_function method.
-  // There is also another hidden parameter to every function for the environment from which it was
-  // called (its closure). This also gets handled by the define_function method
+  // Functions that capture bindings from the scope they are defined in also get another hidden
+  // parameter for this environment (its closure). This also gets handled by the define_function
+  // method
   const llvm::FunctionType *prototype = this->type->get_llvm_type(compiler);
-  llvm::Function *function =
-      compiler.define_function(prototype, this->name, *this->body, this->parameters);
+  std::variant<llvm::Function *, MemoizationError> function =
+      compiler.define_function(prototype, this->name, *this->body, this->parameters,
+                               this->referenced_names, this->effects, this->is_memoized);
+  if (std::holds_alternative<MemoizationError>(function))
+    this->compiler_error(std::get<MemoizationError>(function));
+
+  return std::get<llvm::Function *>(function);
+}
+
+void FunctionConstructor::collect_referenced_names(std::set<std::string> &names) const {
+  names.insert(this->referenced_names.begin(), this->referenced_names.end());
+}
 
-  return function;
+void FunctionConstructor::collect_effects(Effects &effects) const {
+  // The environment of a closure is moved to the heap if the closure escapes
+  if (!this->referenced_names.empty())
+    effects.add(Effect::SIDE_EFFECTS);
+  effects.add(this->effects);
 }
 
 void PrimitiveConstructor::parse_type(Lexer &lexer) { this->type = PrimitiveType::parse(lexer); }
@@ -172,15 +231,27 @@ std::unique_ptr<PrimitiveConstructor> PrimitiveConstructor::parse(Lexer &lexer)
 }
 
 llvm::Value *PrimitiveConstructor::compile(Compiler &compiler) const {
-  compiler.start_scope();
+  compiler.start_constructor_scope();
   for (size_t i = 0; i < this->body.size() - 1; ++i)
     this->body[i]->compile(compiler);
 
   // Return value of each constructor is the last statement (which is an expression)
   llvm::Value *return_value = this->body.back()->compile(compiler);
-  compiler.end_scope();
+  compiler.end_constructor_scope(return_value);
 
   return return_value;
 }
 
+void PrimitiveConstructor::mark_tail_position() { this->body.back()->mark_tail_position(); }
+
+void PrimitiveConstructor::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Statement> &statement : this->body)
+    statement->collect_referenced_names(names);
+}
+
+void PrimitiveConstructor::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<Statement> &statement : this->body)
+    statement->collect_effects(effects);
+}
+
 } // namespace Kebab::Parser
@@ -2,6 +2,8 @@
 #define KEBAB_CONSTRUCTOR_HPP
 
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 #include "compiler/Compiler.hpp"
@@ -42,6 +44,9 @@ public:
 
   static std::unique_ptr<ListConstructor> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
   std::shared_ptr<Type> get_type() const final { return this->type; }
 };
 
@@ -60,14 +65,25 @@ class FunctionConstructor : public Constructor {
 private:
   void parse_type(Lexer &lexer) final;
   void parse_body(Lexer &lexer) final;
+  // Remove calls and assignments of names local to the function from its effects
+  void resolve_local_effects();
 
 public:
   std::vector<std::unique_ptr<FunctionParameter>> parameters;
   std::shared_ptr<FunctionType> type;
   std::unique_ptr<Constructor> body;
+  // Names used in the body other than the parameters, the ones bound in the scope the function is
+  // defined in are captured in its closure environment
+  std::set<std::string> referenced_names;
+  // What the body does besides returning a value, other than what the names it calls do
+  Effects effects;
+  // Calls of memoized functions look up their arguments in a cache before running the body
+  bool is_memoized = false;
 
   static std::unique_ptr<FunctionConstructor> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
   std::shared_ptr<Type> get_type() const final { return this->type; }
 };
 
@@ -82,6 +98,9 @@ public:
 
   static std::unique_ptr<PrimitiveConstructor> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
   std::shared_ptr<Type> get_type() const final { return this->type; }
 };
 
@@ -13,6 +13,7 @@
 #include "parser/Expression.hpp"
 #include "parser/Statement.hpp"
 #include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Value.h"
 
@@ -130,13 +131,32 @@ std::unique_ptr<CondExpression> CondExpression::parse(Lexer &lexer) {
   return expression;
 }
 
-// Compile the body of the branch and ensure local variables are scoped correctly
-static llvm::Value *compile_branch_body(Compiler &compiler,
-                                        const std::vector<std::unique_ptr<Statement>> &body) {
+// Compile the body of the branch and ensure local variables are scoped correctly. Branches in tail
+// position return their value directly, other branches pass it on to the phi in `merge_branch` (if
+// there is one, bodies without it are the only way through the expression)
+static llvm::Value *
+compile_branch_body(Compiler &compiler, const std::vector<std::unique_ptr<Statement>> &body,
+                    bool is_tail, llvm::BasicBlock *merge_branch,
+                    std::vector<std::pair<llvm::Value *, llvm::BasicBlock *>> &incoming_values) {
+  compiler.start_scope();
   for (size_t j = 0; j < body.size() - 1; ++j)
     body[j]->compile(compiler);
 
-  return body.back()->compile(compiler);
+  llvm::Value *return_value = body.back()->compile(compiler);
+  compiler.end_scope();
+
+  if (is_tail) {
+    // A tail call at the end of the body has already returned or jumped back to the loop header
+    if (!compiler.is_block_terminated())
+      compiler.create_return(return_value);
+  } else if (merge_branch != nullptr) {
+    // The body may have introduced new blocks (e.g. short circuiting `and`/`or`) so the incoming
+    // value comes from wherever the body ended up rather than the block we started in
+    incoming_values.push_back({return_value, compiler.get_insert_block()});
+    compiler.create_branch(merge_branch);
+  }
+
+  return return_value;
 }
 
 // TODO: this whole function is way too big
@@ -144,7 +164,9 @@ llvm::Value *CondExpression::compile(Compiler &compiler) const {
   llvm::Function *current_function = compiler.get_current_function();
 
   llvm::BasicBlock *branch = compiler.create_basic_block(current_function, "if_branch");
-  llvm::BasicBlock *merge_branch = compiler.create_basic_block(current_function, "merge_branch");
+  // Branches in tail position all return so there is nothing to merge
+  llvm::BasicBlock *merge_branch =
+      this->is_tail ? nullptr : compiler.create_basic_block(current_function, "merge_branch");
 
   // llvm does not allow 2 labels in a row so we need to make a branch here in case there are no
   // preceding instructions in the function
@@ -153,8 +175,8 @@ llvm::Value *CondExpression::compile(Compiler &compiler) const {
   // Vector of possible incoming values to the phi node (the return value of the cond expression)
   std::vector<std::pair<llvm::Value *, llvm::BasicBlock *>> incoming_values;
 
-  // if/elif branches (each branch branches to the merge branch if true, next elif branch (or else
-  // branch for last elif) if false)
+  // if/elif branches (each branch branches to its body if true, next elif branch (or else branch
+  // for last elif) if false). Bodies get their own block so only the selected one is evaluated
   size_t num_tests = this->tests.size();
   for (size_t i = 0; i < num_tests; ++i) {
     compiler.set_insert_point(branch);
@@ -165,30 +187,78 @@ llvm::Value *CondExpression::compile(Compiler &compiler) const {
     if (std::holds_alternative<BinaryOperatorError>(test_is_true))
       this->compiler_error(std::get<BinaryOperatorError>(test_is_true));
 
+    // Tests known while compiling do not need a branch. Bodies that are never taken are not
+    // compiled at all and a body that is always taken ends the expression like the else would
+    if (auto *constant = llvm::dyn_cast<llvm::ConstantInt>(std::get<llvm::Value *>(test_is_true))) {
+      if (constant->isZero())
+        continue;
+
+      return this->compile_last_body(compiler, this->bodies[i], branch, merge_branch,
+                                     incoming_values);
+    }
+
+    std::string body_name = (i == 0) ? "if_body" : "elif_body";
     std::string branch_name = (i == num_tests - 1) ? "else_branch" : "elif_branch";
 
+    llvm::BasicBlock *body_branch = compiler.create_basic_block(current_function, body_name);
     llvm::BasicBlock *next_branch = compiler.create_basic_block(current_function, branch_name);
+    compiler.create_cond_branch(std::get<llvm::Value *>(test_is_true), body_branch, next_branch);
 
-    compiler.start_scope();
-    llvm::Value *current_return_value = compile_branch_body(compiler, this->bodies[i]);
-    compiler.end_scope();
-
-    compiler.create_cond_branch(std::get<llvm::Value *>(test_is_true), merge_branch, next_branch);
-    incoming_values.push_back({current_return_value, branch});
+    compiler.set_insert_point(body_branch);
+    compile_branch_body(compiler, this->bodies[i], this->is_tail, merge_branch, incoming_values);
     branch = next_branch;
   }
 
-  // else branch
+  return this->compile_last_body(compiler, this->bodies.back(), branch, merge_branch,
+                                 incoming_values);
+}
+
+llvm::Value *CondExpression::compile_last_body(
+    Compiler &compiler, const std::vector<std::unique_ptr<Statement>> &body,
+    llvm::BasicBlock *branch, llvm::BasicBlock *merge_branch,
+    std::vector<std::pair<llvm::Value *, llvm::BasicBlock *>> &incoming_values) const {
   compiler.set_insert_point(branch);
-  compiler.start_scope();
-  llvm::Value *else_return_value = compile_branch_body(compiler, this->bodies.back());
-  compiler.end_scope();
-  incoming_values.push_back({else_return_value, branch});
 
-  compiler.create_branch(merge_branch);
+  // If every test before this body was known to be false it is the only way through, so its value
+  // is the value of the whole expression
+  if (!this->is_tail && incoming_values.empty()) {
+    merge_branch->eraseFromParent();
+    return compile_branch_body(compiler, body, false, nullptr, incoming_values);
+  }
+
+  llvm::Value *return_value =
+      compile_branch_body(compiler, body, this->is_tail, merge_branch, incoming_values);
+
+  // Nothing can follow a cond expression in tail position, its value is never used
+  if (this->is_tail)
+    return return_value;
+
   compiler.set_insert_point(merge_branch);
+  return compiler.create_phi(return_value->getType(), incoming_values);
+}
 
-  return compiler.create_phi(else_return_value->getType(), incoming_values);
+void CondExpression::mark_tail_position() {
+  this->is_tail = true;
+  for (const std::vector<std::unique_ptr<Statement>> &body : this->bodies)
+    body.back()->mark_tail_position();
+}
+
+void CondExpression::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Expression> &test : this->tests)
+    test->collect_referenced_names(names);
+
+  for (const std::vector<std::unique_ptr<Statement>> &body : this->bodies)
+    for (const std::unique_ptr<Statement> &statement : body)
+      statement->collect_referenced_names(names);
+}
+
+void CondExpression::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<Expression> &test : this->tests)
+    test->collect_effects(effects);
+
+  for (const std::vector<std::unique_ptr<Statement>> &body : this->bodies)
+    for (const std::unique_ptr<Statement> &statement : body)
+      statement->collect_effects(effects);
 }
 
 std::unique_ptr<NormalExpression> NormalExpression::parse(Lexer &lexer) {
@@ -211,8 +281,10 @@ llvm::Value *NormalExpression::compile(Compiler &compiler) const {
   llvm::Value *result = this->and_tests.front()->compile(compiler);
 
   for (size_t i = 1; i < and_tests.size(); ++i) {
-    llvm::Value *rhs = this->and_tests[i]->compile(compiler);
-    std::variant<llvm::Value *, BinaryOperatorError> operation = compiler.create_or(result, rhs);
+    // Only evaluate the rhs if all the previous and tests were false
+    auto compile_rhs = [this, &compiler, i]() { return this->and_tests[i]->compile(compiler); };
+    std::variant<llvm::Value *, BinaryOperatorError> operation =
+        compiler.create_or(result, compile_rhs);
     if (std::holds_alternative<llvm::Value *>(operation))
       result = std::get<llvm::Value *>(operation);
     else
@@ -222,6 +294,21 @@ llvm::Value *NormalExpression::compile(Compiler &compiler) const {
   return result;
 }
 
+void NormalExpression::mark_tail_position() {
+  if (this->and_tests.size() == 1)
+    this->and_tests.front()->mark_tail_position();
+}
+
+void NormalExpression::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<AndTest> &and_test : this->and_tests)
+    and_test->collect_referenced_names(names);
+}
+
+void NormalExpression::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<AndTest> &and_test : this->and_tests)
+    and_test->collect_effects(effects);
+}
+
 std::unique_ptr<FunctionExpression> FunctionExpression::parse(Lexer &lexer) {
   auto expression = std::make_unique<FunctionExpression>();
   expression->start_parsing(lexer, "<function-expression>");
@@ -237,4 +324,12 @@ llvm::Value *FunctionExpression::compile(Compiler &compiler) const {
   return this->function->compile(compiler);
 }
 
+void FunctionExpression::collect_referenced_names(std::set<std::string> &names) const {
+  this->function->collect_referenced_names(names);
+}
+
+void FunctionExpression::collect_effects(Effects &effects) const {
+  this->function->collect_effects(effects);
+}
+
 } // namespace Kebab::Parser
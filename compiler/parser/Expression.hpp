@@ -29,13 +29,24 @@ private:
   void parse_elif(Lexer &lexer);
   void parse_elifs(Lexer &lexer);
   void parse_else(Lexer &lexer);
+  // Compile the body every remaining path goes through (usually the else branch) and merge the
+  // values of all bodies
+  llvm::Value *compile_last_body(
+      Compiler &compiler, const std::vector<std::unique_ptr<Statement>> &body,
+      llvm::BasicBlock *branch, llvm::BasicBlock *merge_branch,
+      std::vector<std::pair<llvm::Value *, llvm::BasicBlock *>> &incoming_values) const;
 
 public:
   std::vector<std::unique_ptr<Expression>> tests;
   std::vector<std::vector<std::unique_ptr<Statement>>> bodies;
+  // Each branch returns from the function directly instead of merging into a phi
+  bool is_tail = false;
 
   static std::unique_ptr<CondExpression> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 class NormalExpression : public Expression {
@@ -44,6 +55,9 @@ public:
 
   static std::unique_ptr<NormalExpression> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 class FunctionExpression : public Expression {
@@ -52,6 +66,8 @@ public:
 
   static std::unique_ptr<FunctionExpression> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 } // namespace Kebab::Parser
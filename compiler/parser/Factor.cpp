@@ -1,6 +1,7 @@
 #include <cassert>
 #include <optional>
 #include <variant>
+#include <vector>
 
 #include "compiler/Errors.hpp"
 #include "parser/Expression.hpp"
@@ -85,10 +86,22 @@ llvm::Value *Factor::compile_with_prefix(Compiler &compiler, size_t index) const
 }
 
 llvm::Value *Factor::compile(Compiler &compiler) const {
-  llvm::Value *result = this->compile_with_prefix(compiler, 0);
+  std::vector<const Primary *> calls;
+  for (size_t i = 0; i < this->primaries.size(); ++i)
+    calls.push_back(this->prefixes[i].has_value() ? nullptr : this->primaries[i].get());
 
+  auto compile_primary = [this, &compiler](size_t i) {
+    return this->compile_with_prefix(compiler, i);
+  };
+  std::optional<std::vector<llvm::Value *>> forked =
+      Primary::compile_forked(compiler, calls, compile_primary);
+  auto get_primary = [&forked, &compile_primary](size_t i) {
+    return forked.has_value() ? forked->at(i) : compile_primary(i);
+  };
+
+  llvm::Value *result = get_primary(0);
   for (size_t i = 0; i < this->operators.size(); ++i) {
-    llvm::Value *rhs = this->compile_with_prefix(compiler, i + 1);
+    llvm::Value *rhs = get_primary(i + 1);
     this->operators[i]->lhs = result;
     this->operators[i]->rhs = rhs;
     result = this->operators[i]->compile(compiler);
@@ -97,6 +110,27 @@ llvm::Value *Factor::compile(Compiler &compiler) const {
   return result;
 }
 
+const Primary *Factor::get_only_primary() const {
+  if (this->primaries.size() == 1 && !this->prefixes.front().has_value())
+    return this->primaries.front().get();
+  return nullptr;
+}
+
+void Factor::mark_tail_position() {
+  if (this->primaries.size() == 1 && !this->prefixes.front().has_value())
+    this->primaries.front()->mark_tail_position();
+}
+
+void Factor::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Primary> &primary : this->primaries)
+    primary->collect_referenced_names(names);
+}
+
+void Factor::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<Primary> &primary : this->primaries)
+    primary->collect_effects(effects);
+}
+
 std::unique_ptr<FactorOperator> FactorOperator::parse(Lexer &lexer) {
   auto operator_ = std::make_unique<FactorOperator>();
   operator_->start_parsing(lexer, "<factor-operator>");
@@ -90,6 +90,12 @@ public:
 
   static std::unique_ptr<Factor> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
+
+  // Null unless the factor is a single primary without a prefix
+  const Primary *get_only_primary() const;
 };
 
 } // namespace Kebab::Parser
@@ -43,4 +43,17 @@ llvm::Value *NotTest::compile(Compiler &compiler) const {
     this->compiler_error(std::get<UnaryOperatorError>(operation));
 }
 
+void NotTest::mark_tail_position() {
+  if (!this->is_negated)
+    this->comparison->mark_tail_position();
+}
+
+void NotTest::collect_referenced_names(std::set<std::string> &names) const {
+  this->comparison->collect_referenced_names(names);
+}
+
+void NotTest::collect_effects(Effects &effects) const {
+  this->comparison->collect_effects(effects);
+}
+
 } // namespace Kebab::Parser
@@ -14,6 +14,9 @@ public:
 
   static std::unique_ptr<NotTest> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 } // namespace Kebab::Parser
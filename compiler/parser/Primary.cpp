@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <cassert>
 #include <optional>
 #include <variant>
 #include <vector>
@@ -40,14 +39,25 @@ llvm::Value *PrimarySubscription::compile(Compiler &compiler) const {
   if (auto error = UnsubscriptableError::check(this->subscriptee); error.has_value())
     this->compiler_error(error.value());
 
-  // Dont index if out of range (currently unimplemented, and should maybe be removed since we
-  // cannot check this at compiletime with heap allocated lists)
-  if (auto error = IndexError::check(this->subscriptee, index); error.has_value())
+  // Dont index if out of range, indices that are not known yet are checked at runtime instead
+  if (auto error = IndexError::check(index, compiler.get_list_length(this->subscriptee));
+      error.has_value())
     this->compiler_error(error.value());
 
   return compiler.create_subscription(this->subscriptee, index);
 }
 
+void PrimarySubscription::collect_referenced_names(std::set<std::string> &names) const {
+  this->subscription->collect_referenced_names(names);
+}
+
+void PrimarySubscription::collect_effects(Effects &effects) const {
+  // Indexes that are out of bounds end the program instead of returning
+  effects.add(Effect::READS_MEMORY);
+  effects.always_returns = false;
+  this->subscription->collect_effects(effects);
+}
+
 std::unique_ptr<PrimaryArguments> PrimaryArguments::parse(Lexer &lexer) {
   auto arguments = std::make_unique<PrimaryArguments>();
   arguments->start_parsing(lexer, "<primary-arguments>");
@@ -70,22 +80,53 @@ llvm::Value *PrimaryArguments::compile(Compiler &compiler) const {
   for (const std::unique_ptr<Expression> &argument : this->arguments)
     arguments_compiled.push_back(argument->compile(compiler));
 
-  if (auto error = UncallableError::check(this->subscriptee); error.has_value())
+  const llvm::FunctionType *closure_signature = compiler.get_closure_signature(this->subscriptee);
+  if (auto error = UncallableError::check(this->subscriptee, closure_signature); error.has_value())
     this->compiler_error(error.value());
 
-  if (auto *function = llvm::dyn_cast<llvm::Function>(this->subscriptee); function != nullptr) {
-    std::variant<llvm::CallInst *, ArgumentCountError> call =
-        compiler.create_call(function, arguments_compiled);
-    if (std::holds_alternative<ArgumentCountError>(call))
-      this->compiler_error(std::get<ArgumentCountError>(call));
-    else
-      return std::get<llvm::CallInst *>(call);
-  } else {
-    // This means the variable is a function pointer - need to get the type of the pointed to
-    // function
-    assert(false && "calling from function pointers is so hard to do with opaque pointers, haven't "
-                    "figured out yet");
-  }
+  // Functions known by name are called directly, anything else is a closure value (e.g. an element
+  // of a list) which is called through the function it holds
+  std::variant<llvm::Value *, ArgumentCountError> call;
+  if (auto *function = llvm::dyn_cast<llvm::Function>(this->subscriptee); function != nullptr)
+    call = compiler.create_call(function, arguments_compiled, this->is_tail_call);
+  else
+    call = compiler.create_closure_call(this->subscriptee, arguments_compiled, this->is_tail_call);
+
+  if (std::holds_alternative<ArgumentCountError>(call))
+    this->compiler_error(std::get<ArgumentCountError>(call));
+  else
+    return std::get<llvm::Value *>(call);
+}
+
+Compiler::Task PrimaryArguments::compile_spawn(Compiler &compiler) const {
+  std::vector<llvm::Value *> arguments_compiled;
+  for (const std::unique_ptr<Expression> &argument : this->arguments)
+    arguments_compiled.push_back(argument->compile(compiler));
+
+  std::variant<Compiler::Task, ArgumentCountError> task =
+      compiler.create_spawn(llvm::cast<llvm::Function>(this->subscriptee), arguments_compiled);
+
+  if (std::holds_alternative<ArgumentCountError>(task))
+    this->compiler_error(std::get<ArgumentCountError>(task));
+  else
+    return std::get<Compiler::Task>(task);
+}
+
+void PrimaryArguments::mark_tail_position() { this->is_tail_call = true; }
+
+void PrimaryArguments::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Expression> &argument : this->arguments)
+    argument->collect_referenced_names(names);
+}
+
+void PrimaryArguments::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<Expression> &argument : this->arguments)
+    argument->collect_effects(effects);
+
+  if (this->callee_name.has_value())
+    effects.called_names.insert(this->callee_name.value());
+  else
+    effects.add_unknown_call();
 }
 
 std::unique_ptr<PrimarySuffix> PrimarySuffix::parse(Lexer &lexer) {
@@ -117,6 +158,12 @@ std::unique_ptr<Primary> Primary::parse(Lexer &lexer) {
   while (PrimarySuffix::is_primary_suffix_opener(lexer.peek()->type))
     primary->suffixes.push_back(PrimarySuffix::parse(lexer));
 
+  // Calls directly on a name call whatever the name is bound to, which is known once it is compiled
+  if (auto *name = dynamic_cast<NameAtom *>(primary->atom.get());
+      name != nullptr && !primary->suffixes.empty())
+    if (auto *arguments = dynamic_cast<PrimaryArguments *>(primary->suffixes.front().get()))
+      arguments->callee_name = name->name;
+
   primary->finish_parsing(lexer, "</primary>");
   return primary;
 }
@@ -132,4 +179,71 @@ llvm::Value *Primary::compile(Compiler &compiler) const {
   return result;
 }
 
+void Primary::mark_tail_position() {
+  // Only the last suffix is evaluated last, e.g. in `f(x)[0]` the call is not in tail position
+  if (this->suffixes.empty())
+    this->atom->mark_tail_position();
+  else
+    this->suffixes.back()->mark_tail_position();
+}
+
+void Primary::collect_referenced_names(std::set<std::string> &names) const {
+  this->atom->collect_referenced_names(names);
+  for (const std::unique_ptr<PrimarySuffix> &suffix : this->suffixes)
+    suffix->collect_referenced_names(names);
+}
+
+void Primary::collect_effects(Effects &effects) const {
+  this->atom->collect_effects(effects);
+  for (const std::unique_ptr<PrimarySuffix> &suffix : this->suffixes)
+    suffix->collect_effects(effects);
+}
+
+bool Primary::is_spawnable(const Compiler &compiler) const {
+  if (this->suffixes.size() != 1)
+    return false;
+
+  const auto *arguments = dynamic_cast<const PrimaryArguments *>(this->suffixes.front().get());
+  return arguments != nullptr && arguments->callee_name.has_value() &&
+         compiler.is_spawnable(arguments->callee_name.value());
+}
+
+Compiler::Task Primary::compile_spawn(Compiler &compiler) const {
+  auto *arguments = static_cast<PrimaryArguments *>(this->suffixes.front().get());
+  arguments->subscriptee = this->atom->compile(compiler);
+  return arguments->compile_spawn(compiler);
+}
+
+std::optional<std::vector<llvm::Value *>>
+Primary::compile_forked(Compiler &compiler, const std::vector<const Primary *> &calls,
+                        const std::function<llvm::Value *(size_t)> &compile_operand) {
+  std::vector<bool> is_spawned(calls.size(), false);
+  std::optional<size_t> last_call = std::nullopt;
+  for (size_t i = 0; i < calls.size(); ++i)
+    if (calls[i] != nullptr && calls[i]->is_spawnable(compiler)) {
+      if (last_call.has_value())
+        is_spawned[last_call.value()] = true;
+      last_call = i;
+    }
+
+  if (std::ranges::find(is_spawned, true) == is_spawned.end())
+    return std::nullopt;
+
+  // The last call runs on the current thread in the meantime, as does everything that is not
+  // spawned. Joining happens in the reverse order of spawning
+  std::vector<std::optional<Compiler::Task>> tasks(calls.size(), std::nullopt);
+  std::vector<llvm::Value *> operands(calls.size(), nullptr);
+  for (size_t i = 0; i < calls.size(); ++i)
+    if (is_spawned[i])
+      tasks[i] = calls[i]->compile_spawn(compiler);
+    else
+      operands[i] = compile_operand(i);
+
+  for (size_t i = calls.size(); i-- > 0;)
+    if (tasks[i].has_value())
+      operands[i] = compiler.create_join(tasks[i].value());
+
+  return operands;
+}
+
 } // namespace Kebab::Parser
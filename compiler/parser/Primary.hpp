@@ -1,6 +1,8 @@
 #ifndef KEBAB_PRIMARY_HPP
 #define KEBAB_PRIMARY_HPP
 
+#include <functional>
+#include <optional>
 #include <vector>
 
 #include "lexer/Lexer.hpp"
@@ -36,14 +38,23 @@ public:
 
   static std::unique_ptr<PrimarySubscription> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 class PrimaryArguments : public PrimarySuffix {
 public:
   std::vector<std::unique_ptr<Expression>> arguments;
+  bool is_tail_call = false;
+  // Set if the arguments directly follow a name, e.g. `f(x)` but not `l[0](x)`
+  std::optional<std::string> callee_name = std::nullopt;
 
   static std::unique_ptr<PrimaryArguments> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  Compiler::Task compile_spawn(Compiler &compiler) const;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
 };
 
 class Primary : public AstNode {
@@ -53,6 +64,19 @@ public:
 
   static std::unique_ptr<Primary> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
+
+  // Whether the primary is only a call that can run in parallel, e.g. `f(x)` but not `f(x)[0]`
+  bool is_spawnable(const Compiler &compiler) const;
+  Compiler::Task compile_spawn(Compiler &compiler) const;
+  // Compile operands where the ones that are spawnable calls (`calls[i]` or null for the others)
+  // run in parallel with each other. Empty if there are not enough of them for that to happen, the
+  // caller compiles the operands itself then
+  static std::optional<std::vector<llvm::Value *>>
+  compile_forked(Compiler &compiler, const std::vector<const Primary *> &calls,
+                 const std::function<llvm::Value *(size_t)> &compile_operand);
 };
 
 } // namespace Kebab::Parser
@@ -19,24 +19,30 @@ std::unique_ptr<DefinitionStatement> DefinitionStatement::parse(Lexer &lexer) {
 
   lexer.skip({Token::Type::DEF});
 
-  if (lexer.peek()->type == Token::Type::MUT) {
-    definition->is_mutable = true;
+  definition->is_mutable = lexer.peek()->type == Token::Type::MUT;
+  definition->is_memoized = lexer.peek()->type == Token::Type::MEMO;
+  if (definition->is_mutable || definition->is_memoized)
     lexer.advance();
-  } else {
-    definition->is_mutable = false;
-  }
 
   definition->name = lexer.skip_name();
   lexer.skip({Token::Type::EQUALS});
   definition->constructor = Constructor::parse(lexer);
+  // TODO: can use this more in constructor::compile methods, but this is still kinda shit
+  definition->constructor->name = definition->name;
+
+  if (definition->is_memoized) {
+    auto *function = dynamic_cast<FunctionConstructor *>(definition->constructor.get());
+    if (function == nullptr)
+      AstNode::parser_error("only functions can be memoized", lexer);
+
+    function->is_memoized = true;
+  }
 
   definition->finish_parsing(lexer, "</definition-statement>");
   return definition;
 }
 
 llvm::Value *DefinitionStatement::compile(Compiler &compiler) const {
-  // TODO: can use this more in constructor::compile methods, but this is still kinda shit
-  this->constructor->name = this->name;
   llvm::Value *variable_value = this->constructor->compile(compiler);
 
   // meh
@@ -48,16 +54,28 @@ llvm::Value *DefinitionStatement::compile(Compiler &compiler) const {
     if (auto error = TypeError::check(declared_type, actual_type); error.has_value())
       this->compiler_error(error.value());
 
-    std::variant<llvm::AllocaInst *, RedefinitionError> local =
+    std::variant<llvm::Value *, RedefinitionError> local =
         compiler.create_definition(this->name, variable_value, this->is_mutable);
 
-    if (std::holds_alternative<llvm::AllocaInst *>(local))
-      return std::get<llvm::AllocaInst *>(local);
+    if (std::holds_alternative<llvm::Value *>(local))
+      return std::get<llvm::Value *>(local);
     else
       this->compiler_error(std::get<RedefinitionError>(local));
   }
 }
 
+void DefinitionStatement::collect_referenced_names(std::set<std::string> &names) const {
+  this->constructor->collect_referenced_names(names);
+}
+
+void DefinitionStatement::collect_effects(Effects &effects) const {
+  if (dynamic_cast<const FunctionConstructor *>(this->constructor.get()) != nullptr)
+    effects.local_functions.insert(this->name);
+  else
+    effects.local_names.insert(this->name);
+  this->constructor->collect_effects(effects);
+}
+
 std::unique_ptr<AssignmentStatement> AssignmentStatement::parse(Lexer &lexer) {
   auto assignment = std::make_unique<AssignmentStatement>();
   assignment->start_parsing(lexer, "<assignment-statement>");
@@ -95,6 +113,16 @@ llvm::Value *AssignmentStatement::compile(Compiler &compiler) const {
   }
 }
 
+void AssignmentStatement::collect_referenced_names(std::set<std::string> &names) const {
+  names.insert(this->name);
+  this->constructor->collect_referenced_names(names);
+}
+
+void AssignmentStatement::collect_effects(Effects &effects) const {
+  effects.assigned_names.insert(this->name);
+  this->constructor->collect_effects(effects);
+}
+
 std::unique_ptr<ExpressionStatement> ExpressionStatement::parse(Lexer &lexer) {
   auto expression = std::make_unique<ExpressionStatement>();
   expression->start_parsing(lexer, "<expression-statement>");
@@ -109,6 +137,16 @@ llvm::Value *ExpressionStatement::compile(Compiler &compiler) const {
   return this->expression->compile(compiler);
 }
 
+void ExpressionStatement::mark_tail_position() { this->expression->mark_tail_position(); }
+
+void ExpressionStatement::collect_referenced_names(std::set<std::string> &names) const {
+  this->expression->collect_referenced_names(names);
+}
+
+void ExpressionStatement::collect_effects(Effects &effects) const {
+  this->expression->collect_effects(effects);
+}
+
 std::unique_ptr<Statement> Statement::parse(Lexer &lexer) {
   std::unique_ptr<Statement> statement;
 
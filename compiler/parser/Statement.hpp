@@ -25,11 +25,15 @@ public:
 class DefinitionStatement : public Statement {
 public:
   bool is_mutable;
+  // Only functions can be memoized, see FunctionConstructor::is_memoized
+  bool is_memoized;
   std::string name;
   std::unique_ptr<Constructor> constructor;
 
   static std::unique_ptr<DefinitionStatement> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
   bool is_expression() const final { return false; }
 };
 
@@ -40,6 +44,8 @@ public:
 
   static std::unique_ptr<AssignmentStatement> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
   bool is_expression() const final { return false; }
 };
 
@@ -49,6 +55,9 @@ public:
 
   static std::unique_ptr<ExpressionStatement> parse(Lexer &lexer);
   llvm::Value *compile(Compiler &compiler) const final;
+  void mark_tail_position() final;
+  void collect_referenced_names(std::set<std::string> &names) const final;
+  void collect_effects(Effects &effects) const final;
   bool is_expression() const final { return true; }
 };
 
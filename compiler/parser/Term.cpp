@@ -1,5 +1,7 @@
 #include <cassert>
+#include <optional>
 #include <variant>
+#include <vector>
 
 #include "compiler/Errors.hpp"
 #include "lexer/Lexer.hpp"
@@ -71,10 +73,20 @@ std::unique_ptr<Term> Term::parse(Lexer &lexer) {
 }
 
 llvm::Value *Term::compile(Compiler &compiler) const {
-  llvm::Value *result = this->factors.front()->compile(compiler);
+  std::vector<const Primary *> calls;
+  for (const std::unique_ptr<Factor> &factor : this->factors)
+    calls.push_back(factor->get_only_primary());
+
+  auto compile_factor = [this, &compiler](size_t i) { return this->factors[i]->compile(compiler); };
+  std::optional<std::vector<llvm::Value *>> forked =
+      Primary::compile_forked(compiler, calls, compile_factor);
+  auto get_factor = [&forked, &compile_factor](size_t i) {
+    return forked.has_value() ? forked->at(i) : compile_factor(i);
+  };
 
+  llvm::Value *result = get_factor(0);
   for (size_t i = 0; i < this->operators.size(); ++i) {
-    llvm::Value *rhs = this->factors[i + 1]->compile(compiler);
+    llvm::Value *rhs = get_factor(i + 1);
     this->operators[i]->lhs = result;
     this->operators[i]->rhs = rhs;
     result = this->operators[i]->compile(compiler);
@@ -83,4 +95,19 @@ llvm::Value *Term::compile(Compiler &compiler) const {
   return result;
 }
 
+void Term::mark_tail_position() {
+  if (this->factors.size() == 1)
+    this->factors.front()->mark_tail_position();
+}
+
+void Term::collect_referenced_names(std::set<std::string> &names) const {
+  for (const std::unique_ptr<Factor> &factor : this->factors)
+    factor->collect_referenced_names(names);
+}
+
+void Term::collect_effects(Effects &effects) const {
+  for (const std::unique_ptr<Factor> &factor : this->factors)
+    factor->collect_effects(effects);
+}
+
 } // namespace Kebab::Parser
@@ -0,0 +1,273 @@
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "runtime/Runtime.hpp"
+
+namespace {
+
+// Allocations are aligned for any primitive type (and pairs of them, e.g. closures)
+constexpr size_t ALIGNMENT = 16;
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+struct alignas(ALIGNMENT) Chunk {
+  Chunk *previous;
+  char *end;
+
+  char *data() { return reinterpret_cast<char *>(this + 1); }
+};
+
+struct Arena {
+  // Newest chunk, older ones are only released once every allocation in the newer ones is
+  Chunk *chunk = nullptr;
+  char *top = nullptr;
+  // The last released chunk is kept so a body entered in a loop doesnt hit malloc every time
+  Chunk *spare = nullptr;
+};
+
+thread_local Arena arena;
+
+bool contains(Chunk *chunk, const char *pointer) {
+  return chunk->data() <= pointer && pointer <= chunk->end;
+}
+
+Chunk *create_chunk(size_t size) {
+  size_t capacity = size > CHUNK_SIZE ? size : CHUNK_SIZE;
+  if (Chunk *spare = arena.spare; spare != nullptr && spare->data() + capacity <= spare->end) {
+    arena.spare = nullptr;
+    return spare;
+  }
+
+  auto *chunk = static_cast<Chunk *>(malloc(sizeof(Chunk) + capacity));
+  if (chunk == nullptr)
+    abort();
+
+  chunk->end = chunk->data() + capacity;
+  return chunk;
+}
+
+void release_chunk(Chunk *chunk) {
+  free(arena.spare);
+  arena.spare = chunk;
+}
+
+// Threads (including the ones running programs) that can spawn tasks or steal them from others
+constexpr int MAX_WORKERS = 64;
+// Once a thread has this many tasks that are not joined yet, spawning runs tasks right away. By
+// then there is enough queued up for the other threads, and the tasks spawned deeper down in the
+// recursion are small enough that handing them over costs more than it gains
+constexpr size_t MAX_PENDING_TASKS = 8;
+
+struct Task {
+  void (*function)(void *);
+  void *frame;
+  std::atomic<bool> is_done;
+};
+
+// Tasks are pushed and popped at the bottom by their owner and stolen from the top by others
+struct Deque {
+  pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+  Task *tasks[MAX_PENDING_TASKS];
+  size_t top = 0;
+  size_t bottom = 0;
+};
+
+struct Pool {
+  Deque deques[MAX_WORKERS];
+  std::atomic<int> worker_count = 0;
+  // Tasks waiting in any deque, idle threads sleep while there are none
+  std::atomic<int> queued = 0;
+  std::atomic<int> sleeping = 0;
+  pthread_mutex_t idle_lock = PTHREAD_MUTEX_INITIALIZER;
+  pthread_cond_t idle = PTHREAD_COND_INITIALIZER;
+};
+
+Pool pool;
+pthread_once_t pool_started = PTHREAD_ONCE_INIT;
+bool has_helpers = false;
+
+struct Worker {
+  // Index into the deques of the pool, -1 until the thread first spawns a task (or steals one) and
+  // -2 if there are no deques left
+  int index = -1;
+  // Spawned tasks are joined in the reverse order of spawning, so their storage is a stack
+  Task tasks[MAX_PENDING_TASKS];
+  size_t pending = 0;
+  uint64_t random = 0;
+};
+
+thread_local Worker worker;
+
+Deque *own_deque() {
+  if (worker.index == -1) {
+    int index = pool.worker_count.fetch_add(1);
+    worker.index = index < MAX_WORKERS ? index : -2;
+    worker.random = static_cast<uint64_t>(index) * 0x9e3779b97f4a7c15 + 1;
+  }
+
+  return worker.index >= 0 ? &pool.deques[worker.index] : nullptr;
+}
+
+void push(Deque *deque, Task *task) {
+  pthread_mutex_lock(&deque->lock);
+  deque->tasks[deque->bottom++ % MAX_PENDING_TASKS] = task;
+  pthread_mutex_unlock(&deque->lock);
+  pool.queued.fetch_add(1);
+
+  if (pool.sleeping.load() > 0) {
+    pthread_mutex_lock(&pool.idle_lock);
+    pthread_cond_signal(&pool.idle);
+    pthread_mutex_unlock(&pool.idle_lock);
+  }
+}
+
+Task *take(Deque *deque, bool from_bottom) {
+  Task *task = nullptr;
+  pthread_mutex_lock(&deque->lock);
+  if (deque->top != deque->bottom)
+    task = from_bottom ? deque->tasks[--deque->bottom % MAX_PENDING_TASKS]
+                       : deque->tasks[deque->top++ % MAX_PENDING_TASKS];
+  pthread_mutex_unlock(&deque->lock);
+
+  if (task != nullptr)
+    pool.queued.fetch_sub(1);
+  return task;
+}
+
+Task *steal() {
+  int count = pool.worker_count.load();
+  count = count < MAX_WORKERS ? count : MAX_WORKERS;
+
+  // Start at a random victim so thieves dont all go after the same one
+  worker.random ^= worker.random << 13;
+  worker.random ^= worker.random >> 7;
+  worker.random ^= worker.random << 17;
+  for (int i = 0, start = static_cast<int>(worker.random % count); i < count; ++i)
+    if (int victim = (start + i) % count; victim != worker.index)
+      if (Task *task = take(&pool.deques[victim], false); task != nullptr)
+        return task;
+
+  return nullptr;
+}
+
+void run(Task *task) {
+  task->function(task->frame);
+  task->is_done.store(true, std::memory_order_release);
+}
+
+void *help(void *) {
+  own_deque();
+
+  while (true) {
+    if (Task *task = steal(); task != nullptr) {
+      run(task);
+      continue;
+    }
+
+    pthread_mutex_lock(&pool.idle_lock);
+    pool.sleeping.fetch_add(1);
+    while (pool.queued.load() == 0)
+      pthread_cond_wait(&pool.idle, &pool.idle_lock);
+    pool.sleeping.fetch_sub(1);
+    pthread_mutex_unlock(&pool.idle_lock);
+  }
+}
+
+// Helper threads are never stopped, they sleep while there is nothing to do and end with the
+// process. Half of the deques are left for threads running programs
+void start_pool() {
+  long processors = sysconf(_SC_NPROCESSORS_ONLN);
+  for (long i = 1; i < processors && i < MAX_WORKERS / 2; ++i) {
+    pthread_t thread;
+    if (pthread_create(&thread, nullptr, help, nullptr) == 0) {
+      pthread_detach(thread);
+      has_helpers = true;
+    }
+  }
+}
+
+} // namespace
+
+extern "C" {
+
+void *kebab_arena_push() { return arena.top; }
+
+void kebab_arena_pop(void *mark) {
+  char *top = static_cast<char *>(mark);
+  while (arena.chunk != nullptr && !contains(arena.chunk, top)) {
+    Chunk *previous = arena.chunk->previous;
+    release_chunk(arena.chunk);
+    arena.chunk = previous;
+  }
+
+  arena.top = arena.chunk != nullptr ? top : nullptr;
+}
+
+void *kebab_arena_alloc(int64_t size) {
+  size_t aligned_size = (static_cast<size_t>(size) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  if (arena.chunk == nullptr || arena.top + aligned_size > arena.chunk->end) {
+    Chunk *chunk = create_chunk(aligned_size);
+    chunk->previous = arena.chunk;
+    arena.chunk = chunk;
+    arena.top = chunk->data();
+  }
+
+  void *allocation = arena.top;
+  arena.top += aligned_size;
+  return allocation;
+}
+
+void *kebab_spawn(void (*function)(void *), void *frame) {
+  pthread_once(&pool_started, start_pool);
+
+  Deque *deque = own_deque();
+  if (!has_helpers || deque == nullptr || worker.pending == MAX_PENDING_TASKS) {
+    function(frame);
+    return nullptr;
+  }
+
+  Task *task = &worker.tasks[worker.pending++];
+  task->function = function;
+  task->frame = frame;
+  task->is_done.store(false, std::memory_order_relaxed);
+  push(deque, task);
+  return task;
+}
+
+void kebab_join(void *handle) {
+  if (handle == nullptr)
+    return;
+
+  // Unless it was stolen the task is still at the bottom of the deque, otherwise help with other
+  // tasks until the thief is done with it
+  auto *task = static_cast<Task *>(handle);
+  Deque *deque = own_deque();
+  while (!task->is_done.load(std::memory_order_acquire)) {
+    Task *next = take(deque, true);
+    if (next == nullptr)
+      next = steal();
+
+    if (next != nullptr)
+      run(next);
+    else
+      sched_yield();
+  }
+
+  --worker.pending;
+}
+
+void kebab_index_error(int64_t index, int64_t length) {
+  fprintf(stderr,
+          "index-error: index %" PRId64 " is out of bounds for list of length %" PRId64 "\n", index,
+          length);
+
+  exit(1);
+}
+}
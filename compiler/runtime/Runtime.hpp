@@ -0,0 +1,26 @@
+#ifndef KEBAB_RUNTIME_HPP
+#define KEBAB_RUNTIME_HPP
+
+#include <cstdint>
+
+// Functions generated code calls into. They use the C ABI so compiled programs can link against
+// the runtime with any linker, and the JIT resolves them from the compiler itself
+extern "C" {
+
+// Lists that cannot outlive the constructor body they are created in are bump allocated from a
+// per thread arena. Entering a body returns a mark, leaving it frees everything allocated since
+void *kebab_arena_push();
+void kebab_arena_pop(void *mark);
+void *kebab_arena_alloc(int64_t size);
+
+// Subscriptions that cannot be checked while compiling call this when the index is out of bounds
+[[noreturn]] void kebab_index_error(int64_t index, int64_t length);
+
+// Fork-join parallelism on a work stealing thread pool. `function(frame)` runs either on another
+// thread or once it is joined, joining waits for it (helping with other tasks in the meantime).
+// Every task has to be joined by the thread that spawned it, in the reverse order of spawning
+void *kebab_spawn(void (*function)(void *), void *frame);
+void kebab_join(void *task);
+}
+
+#endif
@@ -1,31 +1,104 @@
+#include <cstdio>
 #include <string>
 
 #include "Files.hpp"
 #include "compiler/Compiler.hpp"
+#include "compiler/Jit.hpp"
+#include "compiler/PartitionedCompiler.hpp"
 #include "lexer/Lexer.hpp"
 #include "logging/Logger.hpp"
 #include "parser/RootNode.hpp"
 #include "gtest/gtest.h"
+#include "llvm/BinaryFormat/Magic.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 namespace Kebab::Test {
 
-static void compile_file(const std::string &log_path, const std::string &source_path) {
+static void compile_file(const std::string &log_path, const std::string &source_path,
+                         llvm::OptimizationLevel optimization_level,
+                         Compiler::OutputType output_type = Compiler::OutputType::LLVM_IR) {
   Lexer lexer(source_path);
   auto root = Parser::RootNode::parse(lexer);
-  Compiler compiler;
-  compiler.compile(std::move(root), log_path);
+  Compiler compiler(optimization_level);
+  compiler.compile(std::move(root), log_path, output_type);
 }
 
-static void ASSERT_EXPECTED_COMPILATION(const std::string &basename) {
+// Native and bitcode output is not human readable so instead of comparing it against some expected
+// file we only check that the compiler produced the right kind of file
+static llvm::file_magic compiled_file_magic(const std::string &basename,
+                                            Compiler::OutputType output_type,
+                                            const std::string &extension) {
   std::string source_path = "compiler-source/" + basename + ".keb";
-  std::string log_path = "compiler-logs/" + basename + ".ll";
-  std::string expected_path = "compiler-expected/" + basename + ".ll";
+  std::string log_path = "compiler-logs/" + basename + extension;
+
+  Logger::silence();
+  compile_file(log_path, source_path, llvm::OptimizationLevel::O2, output_type);
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(log_path);
+  if (!buffer)
+    return llvm::file_magic::unknown;
+
+  return llvm::identify_magic(buffer.get()->getBuffer());
+}
+
+// Run the main function of a source file in `jit` and return what it printed
+static std::string run_file(Jit &jit, const std::string &basename,
+                            llvm::OptimizationLevel optimization_level, bool parallelize = false) {
+  std::string source_path = "compiler-source/" + basename + ".keb";
+
+  Logger::silence();
+  Lexer lexer(source_path);
+  Compiler compiler(optimization_level, parallelize);
+
+  testing::internal::CaptureStdout();
+  int64_t result = jit.run_main(compiler.compile_for_jit(Parser::RootNode::parse(lexer)));
+  fflush(stdout);
+  std::string output = testing::internal::GetCapturedStdout();
+
+  EXPECT_EQ(result, 0);
+  return output;
+}
+
+static std::string run_partitioned_file(Jit &jit, const std::string &basename,
+                                        llvm::OptimizationLevel optimization_level,
+                                        size_t partition_count, bool parallelize = false) {
+  std::string source_path = "compiler-source/" + basename + ".keb";
+
+  Logger::silence();
+  Lexer lexer(source_path);
+  PartitionedCompiler compiler(optimization_level, parallelize, partition_count, 2);
+
+  testing::internal::CaptureStdout();
+  int64_t result = jit.run_main(compiler.compile_for_jit(Parser::RootNode::parse(lexer)));
+  fflush(stdout);
+  std::string output = testing::internal::GetCapturedStdout();
+
+  EXPECT_EQ(result, 0);
+  return output;
+}
+
+static void compile_partitioned_file(const std::string &log_path, const std::string &source_path,
+                                     size_t partition_count, unsigned int jobs) {
+  Lexer lexer(source_path);
+  PartitionedCompiler compiler(llvm::OptimizationLevel::O0, false, partition_count, jobs);
+  compiler.compile(Parser::RootNode::parse(lexer), log_path);
+}
+
+// Optimized output is stored next to the unoptimized output with a suffix for its optimization
+// level, e.g. `compiler-expected/recursion-O2.ll`
+static void ASSERT_EXPECTED_COMPILATION(
+    const std::string &basename,
+    llvm::OptimizationLevel optimization_level = llvm::OptimizationLevel::O0) {
+  std::string suffix = expected_suffix(optimization_level);
+  std::string source_path = "compiler-source/" + basename + ".keb";
+  std::string log_path = "compiler-logs/" + basename + suffix + ".ll";
+  std::string expected_path = "compiler-expected/" + basename + suffix + ".ll";
 
   Logger::silence();
 
   ASSERT_NO_FATAL_FAILURE({ Lexer lexer(source_path); });
 
-  compile_file(log_path, source_path);
+  compile_file(log_path, source_path, optimization_level);
 
   std::ifstream expected_file(expected_path);
   std::ifstream log_file(log_path);
@@ -77,6 +150,184 @@ TEST(CompilerTest, CompilesDoubleNestedFunctionKeb) {
   ASSERT_EXPECTED_COMPILATION("double-nested-function");
 }
 
+TEST(CompilerTest, CompilesShortCircuitKeb) { ASSERT_EXPECTED_COMPILATION("short-circuit"); }
+
+TEST(CompilerTest, CompilesTailCallsKeb) { ASSERT_EXPECTED_COMPILATION("tail-calls"); }
+
+TEST(CompilerTest, CompilesClosureCapturesKeb) { ASSERT_EXPECTED_COMPILATION("closure-captures"); }
+
+TEST(CompilerTest, CompilesClosureValuesKeb) { ASSERT_EXPECTED_COMPILATION("closure-values"); }
+
+TEST(CompilerTest, CompilesArenaKeb) { ASSERT_EXPECTED_COMPILATION("arena"); }
+
+TEST(CompilerTest, CompilesStackListsKeb) { ASSERT_EXPECTED_COMPILATION("stack-lists"); }
+
+TEST(CompilerTest, CompilesConstantListsKeb) { ASSERT_EXPECTED_COMPILATION("constant-lists"); }
+
+TEST(CompilerTest, CompilesListLengthsKeb) { ASSERT_EXPECTED_COMPILATION("list-lengths"); }
+
+TEST(CompilerTest, CompilesAdvancedListsKeb) { ASSERT_EXPECTED_COMPILATION("advanced-lists"); }
+
+TEST(CompilerTest, CompilesConstantConditionsKeb) {
+  ASSERT_EXPECTED_COMPILATION("constant-conditions");
+}
+
+TEST(CompilerTest, CompilesEffectsKeb) { ASSERT_EXPECTED_COMPILATION("effects"); }
+
+TEST(CompilerTest, CompilesMemoKeb) { ASSERT_EXPECTED_COMPILATION("memo"); }
+
+TEST(CompilerTest, CompilesPartitionsKeb) {
+  Logger::silence();
+  compile_partitioned_file("compiler-logs/partitions.ll", "compiler-source/partitions.keb", 3, 2);
+
+  for (size_t i = 0; i < 3; ++i) {
+    std::ifstream expected_file(
+        PartitionedCompiler::get_partition_path("compiler-expected/partitions.ll", i));
+    std::ifstream log_file(
+        PartitionedCompiler::get_partition_path("compiler-logs/partitions.ll", i));
+    ASSERT_FILES_EQ(expected_file, log_file);
+  }
+}
+
+// However many threads generate them, the partitions are the same
+TEST(CompilerTest, CompilesPartitionsIndependentlyOfJobs) {
+  Logger::silence();
+  compile_partitioned_file("compiler-logs/memo-jobs-1.ll", "compiler-source/memo.keb", 4, 1);
+  compile_partitioned_file("compiler-logs/memo-jobs-4.ll", "compiler-source/memo.keb", 4, 4);
+
+  for (size_t i = 0; i < 4; ++i) {
+    std::ifstream one_job(
+        PartitionedCompiler::get_partition_path("compiler-logs/memo-jobs-1.ll", i));
+    std::ifstream four_jobs(
+        PartitionedCompiler::get_partition_path("compiler-logs/memo-jobs-4.ll", i));
+    ASSERT_FILES_EQ(one_job, four_jobs);
+  }
+}
+
+TEST(CompilerTest, CompilesRecursionKebO1) {
+  ASSERT_EXPECTED_COMPILATION("recursion", llvm::OptimizationLevel::O1);
+}
+
+TEST(CompilerTest, CompilesRecursionKebO2) {
+  ASSERT_EXPECTED_COMPILATION("recursion", llvm::OptimizationLevel::O2);
+}
+
+TEST(CompilerTest, CompilesRecursionKebO3) {
+  ASSERT_EXPECTED_COMPILATION("recursion", llvm::OptimizationLevel::O3);
+}
+
+TEST(CompilerTest, CompilesRecursionTailKebO2) {
+  ASSERT_EXPECTED_COMPILATION("recursion-tail", llvm::OptimizationLevel::O2);
+}
+
+TEST(CompilerTest, CompilesClosuresInnerMutationKebO2) {
+  ASSERT_EXPECTED_COMPILATION("closures-inner-mutation", llvm::OptimizationLevel::O2);
+}
+
+TEST(CompilerTest, EmitsBitcode) {
+  ASSERT_EQ(compiled_file_magic("recursion", Compiler::OutputType::BITCODE, ".bc"),
+            llvm::file_magic::bitcode);
+}
+
+TEST(CompilerTest, EmitsObjectFile) {
+  llvm::file_magic magic = compiled_file_magic("recursion", Compiler::OutputType::OBJECT, ".o");
+  ASSERT_TRUE(magic == llvm::file_magic::elf_relocatable ||
+              magic == llvm::file_magic::macho_object || magic == llvm::file_magic::coff_object);
+}
+
+TEST(CompilerTest, RunsMainInJit) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "recursion", llvm::OptimizationLevel::O0), "55\n3628800\n1024\n");
+}
+
+TEST(CompilerTest, ReusesJitSessionAcrossFiles) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "recursion", llvm::OptimizationLevel::O2), "55\n3628800\n1024\n");
+  ASSERT_EQ(run_file(jit, "recursion-tail", llvm::OptimizationLevel::O2), "32\n");
+}
+
+TEST(CompilerTest, ShortCircuitsLogicalOperators) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "short-circuit", llvm::OptimizationLevel::O0), "evaluated\nevaluated\n");
+}
+
+TEST(CompilerTest, RunsDeepTailRecursionWithoutOptimization) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "tail-calls", llvm::OptimizationLevel::O0), "10000000\n3\n");
+}
+
+TEST(CompilerTest, RunsClosuresCapturingOnlyReferencedBindings) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "closure-captures", llvm::OptimizationLevel::O0), "33\n");
+}
+
+TEST(CompilerTest, RunsClosuresStoredInLists) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "closure-values", llvm::OptimizationLevel::O0), "11\n42\n24\n30\n2\n");
+}
+
+TEST(CompilerTest, RunsListsInConstructorArenas) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "arena", llvm::OptimizationLevel::O0), "10000100000\n4\n4\n");
+}
+
+TEST(CompilerTest, RunsConstantLists) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "constant-lists", llvm::OptimizationLevel::O0), "4\n5\nseven\n");
+}
+
+TEST(CompilerTest, RunsListsOfAnyLength) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "list-lengths", llvm::OptimizationLevel::O0), "6\n30\n8\n8\n");
+}
+
+TEST(CompilerTest, RunsConstantConditions) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "constant-conditions", llvm::OptimizationLevel::O0), "1\n7\n32\n");
+}
+
+TEST(CompilerTest, RunsEffects) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "effects", llvm::OptimizationLevel::O2), "16\n7\n10\n");
+}
+
+TEST(CompilerTest, RunsMemoizedFunctions) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "memo", llvm::OptimizationLevel::O0),
+            "2880067194370816120\n601080390\n");
+}
+
+TEST(CompilerTest, RunsRecursionInParallel) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "recursion", llvm::OptimizationLevel::O0, true), "55\n3628800\n1024\n");
+  ASSERT_EQ(run_file(jit, "recursion", llvm::OptimizationLevel::O2, true), "55\n3628800\n1024\n");
+}
+
+TEST(CompilerTest, RunsForkJoin) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "fork-join", llvm::OptimizationLevel::O2, true),
+            "196418\n74049690\n8\n8\n");
+}
+
+TEST(CompilerTest, RunsPartitionedPrograms) {
+  Jit jit;
+  ASSERT_EQ(run_partitioned_file(jit, "partitions", llvm::OptimizationLevel::O0, 3), "20\n10\n");
+  ASSERT_EQ(run_partitioned_file(jit, "memo", llvm::OptimizationLevel::O2, 2),
+            "2880067194370816120\n601080390\n");
+  ASSERT_EQ(run_partitioned_file(jit, "fork-join", llvm::OptimizationLevel::O2, 2, true),
+            "196418\n74049690\n8\n8\n");
+}
+
+TEST(CompilerTest, RunsNestedLists) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "advanced-lists", llvm::OptimizationLevel::O0), "1\n");
+}
+
+TEST(CompilerTest, RunsListsOnTheStack) {
+  Jit jit;
+  ASSERT_EQ(run_file(jit, "stack-lists", llvm::OptimizationLevel::O0), "15000450000\n");
+}
+
 TEST(CompilerTest, ErrorsWhenWrongArgumentCount) {
   ASSERT_DEATH({ ASSERT_EXPECTED_COMPILATION("argument-count-error"); }, "argument-count-error");
 }
@@ -103,6 +354,20 @@ TEST(CompilerTest, ErrorsWhenAssigningToImmutable) {
       { ASSERT_EXPECTED_COMPILATION("immutable-assignment-error"); }, "immutable-assignment-error");
 }
 
+TEST(CompilerTest, ErrorsWhenMemoizingImpureFunction) {
+  ASSERT_DEATH({ ASSERT_EXPECTED_COMPILATION("memoization-error"); }, "memoization-error");
+}
+
+TEST(CompilerTest, ErrorsWhenIndexOutOfBounds) {
+  ASSERT_DEATH({ ASSERT_EXPECTED_COMPILATION("index-error"); }, "index-error");
+}
+
+TEST(CompilerTest, ErrorsWhenIndexOutOfBoundsAtRuntime) {
+  Jit jit;
+  ASSERT_DEATH({ run_file(jit, "index-error-runtime", llvm::OptimizationLevel::O0); },
+               "index-error: index 3 is out of bounds for list of length 3");
+}
+
 TEST(CompilerTest, ErrorsWhenSubscriptingUnsubscriptable) {
   ASSERT_DEATH({ ASSERT_EXPECTED_COMPILATION("unsubscriptable-error"); }, "unsubscriptable-error");
 }
@@ -134,6 +399,5 @@ TEST(CompilerTest, ErrorsWhenGettingClosureLocalBinding) {
 
 // Disabled tests
 // TEST(CompilerTest, CompilesFunctionReturnKeb) { ASSERT_EXPECTED_COMPILATION("function-return"); }
-// TEST(CompilerTest, CompilesAdvancedLists) { ASSERT_EXPECTED_COMPILATION("advanced-lists"); }
 
 } // namespace Kebab::Test
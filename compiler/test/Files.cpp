@@ -4,6 +4,7 @@
 #include <ostream>
 #include <string>
 
+#include "compiler/PartitionedCompiler.hpp"
 #include "lexer/Lexer.hpp"
 #include "logging/Logger.hpp"
 #include "parser/RootNode.hpp"
@@ -58,9 +59,19 @@ static void replace_one_parser_expected(const std::string &basename) {
   std::unique_ptr<Parser::RootNode> root = Parser::RootNode::parse(lexer);
 }
 
-static void replace_one_compiler_expected(const std::string &basename) {
+std::string expected_suffix(llvm::OptimizationLevel optimization_level) {
+  if (optimization_level == llvm::OptimizationLevel::O0)
+    return "";
+  else
+    return "-O" + std::to_string(optimization_level.getSpeedupLevel());
+}
+
+static void replace_one_compiler_expected(
+    const std::string &basename,
+    llvm::OptimizationLevel optimization_level = llvm::OptimizationLevel::O0) {
   std::string source_path = "compiler-source/" + basename + ".keb";
-  std::string expected_path = "compiler-expected/" + basename + ".ll";
+  std::string expected_path =
+      "compiler-expected/" + basename + expected_suffix(optimization_level) + ".ll";
 
   ASSERT_NO_FATAL_FAILURE({
     Logger::silence();
@@ -69,10 +80,22 @@ static void replace_one_compiler_expected(const std::string &basename) {
 
   Lexer lexer(source_path);
   std::unique_ptr<Parser::RootNode> root = Parser::RootNode::parse(lexer);
-  Compiler compiler;
+  Compiler compiler(optimization_level);
   compiler.compile(std::move(root), expected_path);
 }
 
+// Every partition gets its own expected file, e.g. `compiler-expected/partitions.0.ll`
+static void replace_partitioned_compiler_expected(const std::string &basename,
+                                                  size_t partition_count) {
+  std::string source_path = "compiler-source/" + basename + ".keb";
+  std::string expected_path = "compiler-expected/" + basename + ".ll";
+
+  Logger::silence();
+  Lexer lexer(source_path);
+  PartitionedCompiler compiler(llvm::OptimizationLevel::O0, false, partition_count, 1);
+  compiler.compile(Parser::RootNode::parse(lexer), expected_path);
+}
+
 // NOTE: These don't run on all the files because some of them are expected to fail and therefore do
 // not have an expected file at all
 static void replace_lexer_expected() {
@@ -118,6 +141,24 @@ static void replace_compiler_expected() {
   replace_one_compiler_expected("recursion");
   replace_one_compiler_expected("recursion-tail");
   replace_one_compiler_expected("double-nested-function");
+  replace_one_compiler_expected("short-circuit");
+  replace_one_compiler_expected("tail-calls");
+  replace_one_compiler_expected("closure-captures");
+  replace_one_compiler_expected("closure-values");
+  replace_one_compiler_expected("arena");
+  replace_one_compiler_expected("stack-lists");
+  replace_one_compiler_expected("constant-lists");
+  replace_one_compiler_expected("list-lengths");
+  replace_one_compiler_expected("advanced-lists");
+  replace_one_compiler_expected("constant-conditions");
+  replace_one_compiler_expected("effects");
+  replace_one_compiler_expected("memo");
+  replace_one_compiler_expected("recursion", llvm::OptimizationLevel::O1);
+  replace_one_compiler_expected("recursion", llvm::OptimizationLevel::O2);
+  replace_one_compiler_expected("recursion", llvm::OptimizationLevel::O3);
+  replace_one_compiler_expected("recursion-tail", llvm::OptimizationLevel::O2);
+  replace_one_compiler_expected("closures-inner-mutation", llvm::OptimizationLevel::O2);
+  replace_partitioned_compiler_expected("partitions", 3);
 
   std::cout << "Replaced expected compiler output" << std::endl;
 }
@@ -2,11 +2,19 @@
 #define KEBAB_FILES_HPP
 
 #include <fstream>
+#include <string>
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#include "llvm/Passes/OptimizationLevel.h"
+#pragma clang diagnostic pop
 
 namespace Kebab::Test {
 
 void ASSERT_FILES_EQ(std::ifstream &f1, std::ifstream &f2);
 void replace_expected();
+// Suffix appended to the basename of expected compiler output for a given optimization level
+std::string expected_suffix(llvm::OptimizationLevel optimization_level);
 
 } // namespace Kebab::Test
 
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <cstring>
+
+#include "runtime/Runtime.hpp"
+#include "gtest/gtest.h"
+
+namespace Kebab::Test {
+
+TEST(RuntimeTest, ArenaAllocationsAreAligned) {
+  void *mark = kebab_arena_push();
+  for (int64_t size = 1; size <= 64; ++size)
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(kebab_arena_alloc(size)) % 16, 0);
+  kebab_arena_pop(mark);
+}
+
+TEST(RuntimeTest, ArenaReusesMemoryAfterPop) {
+  void *mark = kebab_arena_push();
+  void *first = kebab_arena_alloc(24);
+  kebab_arena_pop(mark);
+
+  mark = kebab_arena_push();
+  ASSERT_EQ(kebab_arena_alloc(24), first);
+  kebab_arena_pop(mark);
+}
+
+TEST(RuntimeTest, ArenaKeepsAllocationsOfEnclosingScopes) {
+  void *outer_mark = kebab_arena_push();
+  auto *outer = static_cast<int64_t *>(kebab_arena_alloc(sizeof(int64_t) * 3));
+  outer[0] = 1;
+  outer[1] = 2;
+  outer[2] = 3;
+
+  // Enough to need several new chunks, all of which are released again by the pop
+  void *inner_mark = kebab_arena_push();
+  for (int i = 0; i < 64; ++i)
+    memset(kebab_arena_alloc(32 * 1024), 0xff, 32 * 1024);
+  void *large = kebab_arena_alloc(1024 * 1024);
+  memset(large, 0xff, 1024 * 1024);
+  kebab_arena_pop(inner_mark);
+
+  ASSERT_EQ(outer[0], 1);
+  ASSERT_EQ(outer[1], 2);
+  ASSERT_EQ(outer[2], 3);
+  ASSERT_EQ(kebab_arena_push(), inner_mark);
+  kebab_arena_pop(outer_mark);
+}
+
+static void square(void *frame) {
+  auto *value = static_cast<int64_t *>(frame);
+  *value *= *value;
+}
+
+struct Fib {
+  int64_t n;
+  int64_t result;
+};
+
+static void fib(void *frame) {
+  auto *fib_frame = static_cast<Fib *>(frame);
+  if (fib_frame->n < 2) {
+    fib_frame->result = fib_frame->n;
+    return;
+  }
+
+  Fib first = {fib_frame->n - 1, 0};
+  Fib second = {fib_frame->n - 2, 0};
+  void *task = kebab_spawn(fib, &first);
+  fib(&second);
+  kebab_join(task);
+  fib_frame->result = first.result + second.result;
+}
+
+TEST(RuntimeTest, SpawnedTasksAreDoneOnceJoined) {
+  // More tasks than are queued at once, so some of them run right away
+  int64_t values[32];
+  void *tasks[32];
+  for (int64_t i = 0; i < 32; ++i) {
+    values[i] = i;
+    tasks[i] = kebab_spawn(square, &values[i]);
+  }
+  for (int i = 31; i >= 0; --i)
+    kebab_join(tasks[i]);
+
+  for (int64_t i = 0; i < 32; ++i)
+    ASSERT_EQ(values[i], i * i);
+}
+
+TEST(RuntimeTest, TasksCanSpawnTasks) {
+  Fib frame = {25, 0};
+  fib(&frame);
+  ASSERT_EQ(frame.result, 75025);
+}
+
+TEST(RuntimeTest, IndexErrorsExit) {
+  ASSERT_DEATH(kebab_index_error(5, 3),
+               "index-error: index 5 is out of bounds for list of length 3");
+}
+
+} // namespace Kebab::Test
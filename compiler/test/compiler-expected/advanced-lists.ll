@@ -0,0 +1,80 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant { i64, [2 x { ptr, ptr }] } { i64 2, [2 x { ptr, ptr }] [{ ptr, ptr } { ptr @__anonymous_function.closure, ptr null }, { ptr, ptr } { ptr @__anonymous_function.1.closure, ptr null }] }, align 8
+@1 = private unnamed_addr constant { i64, [3 x i64] } { i64 3, [3 x i64] [i64 1, i64 2, i64 3] }, align 8
+@2 = private unnamed_addr constant { i64, [2 x i64] } { i64 2, [2 x i64] [i64 4, i64 5] }, align 8
+@3 = private unnamed_addr constant { i64, [4 x i64] } { i64 4, [4 x i64] [i64 6, i64 7, i64 8, i64 9] }, align 8
+@4 = private unnamed_addr constant { i64, [3 x ptr] } { i64 3, [3 x ptr] [ptr @1, ptr @2, ptr @3] }, align 8
+@5 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %"env:first-fn" = alloca { ptr }, align 8
+  %0 = getelementptr inbounds { ptr }, ptr %"env:first-fn", i32 0, i32 0
+  store ptr @0, ptr %0, align 8
+  %first-list = load ptr, ptr getelementptr ({ i64, [0 x ptr] }, ptr @4, i64 0, i32 1, i64 0), align 8
+  %1 = load i64, ptr %first-list, align 8
+  %2 = icmp ult i64 0, %1
+  br i1 %2, label %index_in_bounds, label %index_out_of_bounds
+
+index_out_of_bounds:                              ; preds = %entry
+  call void @kebab_index_error(i64 0, i64 %1) #2
+  unreachable
+
+index_in_bounds:                                  ; preds = %entry
+  %3 = getelementptr { i64, [0 x i64] }, ptr %first-list, i64 0, i32 1, i64 0
+  %4 = load i64, ptr %3, align 8
+  %5 = call i64 (ptr, ...) @printf(ptr @5, i64 %4)
+  ret i64 0
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @__anonymous_function() #1 {
+entry:
+  ret i64 420
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @__anonymous_function.closure(ptr %closure-env) #1 {
+entry:
+  %0 = tail call tailcc i64 @__anonymous_function()
+  ret i64 %0
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @__anonymous_function.1() #1 {
+entry:
+  ret i64 69
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @__anonymous_function.1.closure(ptr %closure-env) #1 {
+entry:
+  %0 = tail call tailcc i64 @__anonymous_function.1()
+  ret i64 %0
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @first-fn(ptr %closure-env) #0 {
+entry:
+  %0 = getelementptr inbounds { ptr }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:fn-list" = load ptr, ptr %0, align 8
+  %1 = getelementptr { i64, [0 x { ptr, ptr }] }, ptr %"closure-env:fn-list", i64 0, i32 1, i64 0
+  %2 = load { ptr, ptr }, ptr %1, align 8
+  %closure-function = extractvalue { ptr, ptr } %2, 0
+  %closure-env1 = extractvalue { ptr, ptr } %2, 1
+  %3 = tail call tailcc i64 %closure-function(ptr %closure-env1)
+  ret i64 %3
+}
+
+declare void @kebab_index_error(i64, i64)
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind willreturn memory(none) }
+attributes #2 = { noreturn }
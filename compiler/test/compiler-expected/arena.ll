@@ -0,0 +1,250 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@1 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@2 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define internal tailcc i64 @sum-window(i64 %n) #0 {
+entry:
+  %arena = call ptr @kebab_arena_push()
+  %window = call ptr @kebab_arena_alloc(i64 584)
+  %0 = getelementptr inbounds { i64, [72 x i64] }, ptr %window, i32 0, i32 0
+  store i64 72, ptr %0, align 8
+  %1 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 0
+  store i64 %n, ptr %1, align 8
+  %2 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 1
+  store i64 %n, ptr %2, align 8
+  %3 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 2
+  store i64 %n, ptr %3, align 8
+  %4 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 3
+  store i64 %n, ptr %4, align 8
+  %5 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 4
+  store i64 %n, ptr %5, align 8
+  %6 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 5
+  store i64 %n, ptr %6, align 8
+  %7 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 6
+  store i64 %n, ptr %7, align 8
+  %8 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 7
+  store i64 %n, ptr %8, align 8
+  %9 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 8
+  store i64 %n, ptr %9, align 8
+  %10 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 9
+  store i64 %n, ptr %10, align 8
+  %11 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 10
+  store i64 %n, ptr %11, align 8
+  %12 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 11
+  store i64 %n, ptr %12, align 8
+  %13 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 12
+  store i64 %n, ptr %13, align 8
+  %14 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 13
+  store i64 %n, ptr %14, align 8
+  %15 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 14
+  store i64 %n, ptr %15, align 8
+  %16 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 15
+  store i64 %n, ptr %16, align 8
+  %17 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 16
+  store i64 %n, ptr %17, align 8
+  %18 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 17
+  store i64 %n, ptr %18, align 8
+  %19 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 18
+  store i64 %n, ptr %19, align 8
+  %20 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 19
+  store i64 %n, ptr %20, align 8
+  %21 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 20
+  store i64 %n, ptr %21, align 8
+  %22 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 21
+  store i64 %n, ptr %22, align 8
+  %23 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 22
+  store i64 %n, ptr %23, align 8
+  %24 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 23
+  store i64 %n, ptr %24, align 8
+  %25 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 24
+  store i64 %n, ptr %25, align 8
+  %26 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 25
+  store i64 %n, ptr %26, align 8
+  %27 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 26
+  store i64 %n, ptr %27, align 8
+  %28 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 27
+  store i64 %n, ptr %28, align 8
+  %29 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 28
+  store i64 %n, ptr %29, align 8
+  %30 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 29
+  store i64 %n, ptr %30, align 8
+  %31 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 30
+  store i64 %n, ptr %31, align 8
+  %32 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 31
+  store i64 %n, ptr %32, align 8
+  %33 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 32
+  store i64 %n, ptr %33, align 8
+  %34 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 33
+  store i64 %n, ptr %34, align 8
+  %35 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 34
+  store i64 %n, ptr %35, align 8
+  %36 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 35
+  store i64 %n, ptr %36, align 8
+  %37 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 36
+  store i64 %n, ptr %37, align 8
+  %38 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 37
+  store i64 %n, ptr %38, align 8
+  %39 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 38
+  store i64 %n, ptr %39, align 8
+  %40 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 39
+  store i64 %n, ptr %40, align 8
+  %41 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 40
+  store i64 %n, ptr %41, align 8
+  %42 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 41
+  store i64 %n, ptr %42, align 8
+  %43 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 42
+  store i64 %n, ptr %43, align 8
+  %44 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 43
+  store i64 %n, ptr %44, align 8
+  %45 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 44
+  store i64 %n, ptr %45, align 8
+  %46 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 45
+  store i64 %n, ptr %46, align 8
+  %47 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 46
+  store i64 %n, ptr %47, align 8
+  %48 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 47
+  store i64 %n, ptr %48, align 8
+  %49 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 48
+  store i64 %n, ptr %49, align 8
+  %50 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 49
+  store i64 %n, ptr %50, align 8
+  %51 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 50
+  store i64 %n, ptr %51, align 8
+  %52 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 51
+  store i64 %n, ptr %52, align 8
+  %53 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 52
+  store i64 %n, ptr %53, align 8
+  %54 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 53
+  store i64 %n, ptr %54, align 8
+  %55 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 54
+  store i64 %n, ptr %55, align 8
+  %56 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 55
+  store i64 %n, ptr %56, align 8
+  %57 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 56
+  store i64 %n, ptr %57, align 8
+  %58 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 57
+  store i64 %n, ptr %58, align 8
+  %59 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 58
+  store i64 %n, ptr %59, align 8
+  %60 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 59
+  store i64 %n, ptr %60, align 8
+  %61 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 60
+  store i64 %n, ptr %61, align 8
+  %62 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 61
+  store i64 %n, ptr %62, align 8
+  %63 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 62
+  store i64 %n, ptr %63, align 8
+  %64 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 63
+  store i64 %n, ptr %64, align 8
+  %65 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 64
+  store i64 %n, ptr %65, align 8
+  %66 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 65
+  store i64 %n, ptr %66, align 8
+  %67 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 66
+  store i64 %n, ptr %67, align 8
+  %68 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 67
+  store i64 %n, ptr %68, align 8
+  %69 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 68
+  store i64 %n, ptr %69, align 8
+  %70 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 69
+  store i64 %n, ptr %70, align 8
+  %71 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 70
+  store i64 %n, ptr %71, align 8
+  %72 = getelementptr { i64, [72 x i64] }, ptr %window, i64 0, i32 1, i64 71
+  store i64 %n, ptr %72, align 8
+  %73 = getelementptr { i64, [0 x i64] }, ptr %window, i64 0, i32 1, i64 0
+  %74 = load i64, ptr %73, align 8
+  %75 = getelementptr { i64, [0 x i64] }, ptr %window, i64 0, i32 1, i64 71
+  %76 = load i64, ptr %75, align 8
+  %77 = add i64 %74, %76
+  call void @kebab_arena_pop(ptr %arena)
+  ret i64 %77
+}
+
+declare ptr @kebab_arena_alloc(i64)
+
+declare ptr @kebab_arena_push()
+
+declare void @kebab_arena_pop(ptr)
+
+; Function Attrs: nounwind
+define internal tailcc i64 @sum-windows(i64 %n, i64 %acc) #0 {
+entry:
+  br label %tail_recursion
+
+tail_recursion:                                   ; preds = %else_branch, %entry
+  %"tail-recursion:n" = phi i64 [ %n, %entry ], [ %2, %else_branch ]
+  %"tail-recursion:acc" = phi i64 [ %acc, %entry ], [ %4, %else_branch ]
+  br label %if_branch
+
+if_branch:                                        ; preds = %tail_recursion
+  %0 = icmp eq i64 %"tail-recursion:n", 0
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %"tail-recursion:acc"
+
+else_branch:                                      ; preds = %if_branch
+  %2 = sub i64 %"tail-recursion:n", 1
+  %3 = call tailcc i64 @sum-window(i64 %"tail-recursion:n")
+  %4 = add i64 %"tail-recursion:acc", %3
+  br label %tail_recursion
+}
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %"env:second" = alloca { ptr }, align 8
+  %pair = alloca { i64, [2 x i64] }, align 8
+  %base = call tailcc i64 @sum-window(i64 1)
+  %0 = mul i64 %base, 2
+  %1 = getelementptr inbounds { i64, [2 x i64] }, ptr %pair, i32 0, i32 0
+  store i64 2, ptr %1, align 8
+  %2 = getelementptr { i64, [2 x i64] }, ptr %pair, i64 0, i32 1, i64 0
+  store i64 %base, ptr %2, align 8
+  %3 = getelementptr { i64, [2 x i64] }, ptr %pair, i64 0, i32 1, i64 1
+  store i64 %0, ptr %3, align 8
+  %4 = getelementptr { i64, [0 x i64] }, ptr %pair, i64 0, i32 1, i64 0
+  %5 = load i64, ptr %4, align 8
+  %6 = getelementptr { i64, [0 x i64] }, ptr %pair, i64 0, i32 1, i64 1
+  %7 = load i64, ptr %6, align 8
+  %numbers = call ptr @malloc(i64 24)
+  %8 = getelementptr inbounds { i64, [2 x i64] }, ptr %numbers, i32 0, i32 0
+  store i64 2, ptr %8, align 8
+  %9 = getelementptr { i64, [2 x i64] }, ptr %numbers, i64 0, i32 1, i64 0
+  store i64 %5, ptr %9, align 8
+  %10 = getelementptr { i64, [2 x i64] }, ptr %numbers, i64 0, i32 1, i64 1
+  store i64 %7, ptr %10, align 8
+  %11 = getelementptr inbounds { ptr }, ptr %"env:second", i32 0, i32 0
+  store ptr %numbers, ptr %11, align 8
+  %12 = call tailcc i64 @sum-windows(i64 100000, i64 0)
+  %13 = call i64 (ptr, ...) @printf(ptr @0, i64 %12)
+  %14 = getelementptr { i64, [0 x i64] }, ptr %pair, i64 0, i32 1, i64 1
+  %15 = load i64, ptr %14, align 8
+  %16 = call i64 (ptr, ...) @printf(ptr @1, i64 %15)
+  %17 = call tailcc i64 @second(ptr %"env:second")
+  %18 = call i64 (ptr, ...) @printf(ptr @2, i64 %17)
+  ret i64 0
+}
+
+; Function Attrs: nounwind memory(read)
+define internal tailcc i64 @second(ptr %closure-env) #1 {
+entry:
+  %0 = getelementptr inbounds { ptr }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:numbers" = load ptr, ptr %0, align 8
+  %1 = getelementptr { i64, [0 x i64] }, ptr %"closure-env:numbers", i64 0, i32 1, i64 1
+  %2 = load i64, ptr %1, align 8
+  ret i64 %2
+}
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind memory(read) }
@@ -8,14 +8,11 @@ declare i64 @printf(ptr, ...)
 
 declare ptr @malloc(i64)
 
-define i64 @main({} %closure-env) {
+; Function Attrs: nounwind
+define i64 @main() #0 {
 entry:
-  %inner = alloca ptr, align 8
-  store ptr @0, ptr %inner, align 8
-  %my-num = alloca i64, align 8
-  store i64 2, ptr %my-num, align 8
   %0 = call i64 (ptr, ...) @printf(ptr @1)
-  %v = alloca i64, align 8
-  store i64 123, ptr %v, align 8
   ret i64 0
 }
+
+attributes #0 = { nounwind }
@@ -0,0 +1,65 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %total = alloca i64, align 8
+  %"env:shift" = alloca { i64 }, align 8
+  %"env:accumulate" = alloca { ptr, ptr }, align 8
+  store i64 0, ptr %total, align 8
+  %0 = getelementptr inbounds { i64 }, ptr %"env:shift", i32 0, i32 0
+  store i64 10, ptr %0, align 8
+  %1 = getelementptr inbounds { ptr, ptr }, ptr %"env:accumulate", i32 0, i32 0
+  store ptr %total, ptr %1, align 8
+  %2 = getelementptr inbounds { ptr, ptr }, ptr %"env:accumulate", i32 0, i32 1
+  store ptr %"env:shift", ptr %2, align 8
+  %3 = call tailcc i64 @accumulate(i64 2, ptr %"env:accumulate")
+  %4 = call tailcc i64 @accumulate(i64 3, ptr %"env:accumulate")
+  %5 = load i64, ptr %total, align 8
+  %6 = call i64 (ptr, ...) @printf(ptr @0, i64 %5)
+  ret i64 0
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @square(i64 %x) #1 {
+entry:
+  %0 = mul i64 %x, %x
+  ret i64 %0
+}
+
+; Function Attrs: nounwind willreturn memory(read)
+define internal tailcc i64 @shift(i64 %x, ptr %closure-env) #2 {
+entry:
+  %0 = getelementptr inbounds { i64 }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:offset" = load i64, ptr %0, align 8
+  %1 = add i64 %x, %"closure-env:offset"
+  ret i64 %1
+}
+
+; Function Attrs: nounwind willreturn
+define internal tailcc i64 @accumulate(i64 %x, ptr %closure-env) #3 {
+entry:
+  %0 = getelementptr inbounds { ptr, ptr }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:total" = load ptr, ptr %0, align 8
+  %1 = getelementptr inbounds { ptr, ptr }, ptr %closure-env, i32 0, i32 1
+  %"closure-env:env:shift" = load ptr, ptr %1, align 8
+  %2 = load i64, ptr %"closure-env:total", align 8
+  %3 = call tailcc i64 @square(i64 %x)
+  %4 = call tailcc i64 @shift(i64 %3, ptr %"closure-env:env:shift")
+  %5 = add i64 %2, %4
+  store i64 %5, ptr %"closure-env:total", align 8
+  %6 = load i64, ptr %"closure-env:total", align 8
+  ret i64 %6
+}
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind willreturn memory(none) }
+attributes #2 = { nounwind willreturn memory(read) }
+attributes #3 = { nounwind willreturn }
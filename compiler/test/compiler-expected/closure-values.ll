@@ -0,0 +1,116 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@1 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@2 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@3 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@4 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %"env:scale" = alloca { i64 }, align 8
+  %operations = alloca { i64, [3 x { ptr, ptr }] }, align 8
+  %calls = call ptr @malloc(i64 8)
+  store i64 0, ptr %calls, align 8
+  %"env:add-offset" = call ptr @malloc(i64 16)
+  %0 = getelementptr inbounds { i64, ptr }, ptr %"env:add-offset", i32 0, i32 0
+  store i64 10, ptr %0, align 8
+  %1 = getelementptr inbounds { i64, ptr }, ptr %"env:add-offset", i32 0, i32 1
+  store ptr %calls, ptr %1, align 8
+  %2 = getelementptr inbounds { i64 }, ptr %"env:scale", i32 0, i32 0
+  store i64 10, ptr %2, align 8
+  %closure = insertvalue { ptr, ptr } { ptr @add-offset, ptr undef }, ptr %"env:add-offset", 1
+  %"env:__anonymous_function" = call ptr @malloc(i64 8)
+  %3 = getelementptr inbounds { ptr }, ptr %"env:__anonymous_function", i32 0, i32 0
+  store ptr %"env:add-offset", ptr %3, align 8
+  %closure1 = insertvalue { ptr, ptr } { ptr @__anonymous_function, ptr undef }, ptr %"env:__anonymous_function", 1
+  %4 = getelementptr inbounds { i64, [3 x { ptr, ptr }] }, ptr %operations, i32 0, i32 0
+  store i64 3, ptr %4, align 8
+  %5 = getelementptr { i64, [3 x { ptr, ptr }] }, ptr %operations, i64 0, i32 1, i64 0
+  store { ptr, ptr } %closure, ptr %5, align 8
+  %6 = getelementptr { i64, [3 x { ptr, ptr }] }, ptr %operations, i64 0, i32 1, i64 1
+  store { ptr, ptr } { ptr @double.closure, ptr null }, ptr %6, align 8
+  %7 = getelementptr { i64, [3 x { ptr, ptr }] }, ptr %operations, i64 0, i32 1, i64 2
+  store { ptr, ptr } %closure1, ptr %7, align 8
+  %8 = getelementptr { i64, [0 x { ptr, ptr }] }, ptr %operations, i64 0, i32 1, i64 0
+  %9 = load { ptr, ptr }, ptr %8, align 8
+  %closure-function = extractvalue { ptr, ptr } %9, 0
+  %closure-env = extractvalue { ptr, ptr } %9, 1
+  %10 = call tailcc i64 %closure-function(i64 1, ptr %closure-env)
+  %11 = call i64 (ptr, ...) @printf(ptr @0, i64 %10)
+  %12 = getelementptr { i64, [0 x { ptr, ptr }] }, ptr %operations, i64 0, i32 1, i64 1
+  %13 = load { ptr, ptr }, ptr %12, align 8
+  %closure-function2 = extractvalue { ptr, ptr } %13, 0
+  %closure-env3 = extractvalue { ptr, ptr } %13, 1
+  %14 = call tailcc i64 %closure-function2(i64 21, ptr %closure-env3)
+  %15 = call i64 (ptr, ...) @printf(ptr @1, i64 %14)
+  %16 = getelementptr { i64, [0 x { ptr, ptr }] }, ptr %operations, i64 0, i32 1, i64 2
+  %17 = load { ptr, ptr }, ptr %16, align 8
+  %closure-function4 = extractvalue { ptr, ptr } %17, 0
+  %closure-env5 = extractvalue { ptr, ptr } %17, 1
+  %18 = call tailcc i64 %closure-function4(i64 2, ptr %closure-env5)
+  %19 = call i64 (ptr, ...) @printf(ptr @2, i64 %18)
+  %20 = call tailcc i64 @scale(i64 3, ptr %"env:scale")
+  %21 = call i64 (ptr, ...) @printf(ptr @3, i64 %20)
+  %22 = load i64, ptr %calls, align 8
+  %23 = call i64 (ptr, ...) @printf(ptr @4, i64 %22)
+  ret i64 0
+}
+
+; Function Attrs: nounwind willreturn
+define internal tailcc i64 @add-offset(i64 %x, ptr %closure-env) #1 {
+entry:
+  %0 = getelementptr inbounds { i64, ptr }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:offset" = load i64, ptr %0, align 8
+  %1 = getelementptr inbounds { i64, ptr }, ptr %closure-env, i32 0, i32 1
+  %"closure-env:calls" = load ptr, ptr %1, align 8
+  %2 = load i64, ptr %"closure-env:calls", align 8
+  %3 = add i64 %2, 1
+  store i64 %3, ptr %"closure-env:calls", align 8
+  %4 = add i64 %x, %"closure-env:offset"
+  ret i64 %4
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @double(i64 %x) #2 {
+entry:
+  %0 = mul i64 %x, 2
+  ret i64 %0
+}
+
+; Function Attrs: nounwind willreturn memory(read)
+define internal tailcc i64 @scale(i64 %x, ptr %closure-env) #3 {
+entry:
+  %0 = getelementptr inbounds { i64 }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:offset" = load i64, ptr %0, align 8
+  %1 = mul i64 %x, %"closure-env:offset"
+  ret i64 %1
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @double.closure(i64 %x, ptr %closure-env) #2 {
+entry:
+  %0 = tail call tailcc i64 @double(i64 %x)
+  ret i64 %0
+}
+
+; Function Attrs: nounwind willreturn
+define internal tailcc i64 @__anonymous_function(i64 %x, ptr %closure-env) #1 {
+entry:
+  %0 = getelementptr inbounds { ptr }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:env:add-offset" = load ptr, ptr %0, align 8
+  %1 = call tailcc i64 @add-offset(i64 %x, ptr %"closure-env:env:add-offset")
+  %2 = mul i64 %1, 2
+  ret i64 %2
+}
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind willreturn }
+attributes #2 = { nounwind willreturn memory(none) }
+attributes #3 = { nounwind willreturn memory(read) }
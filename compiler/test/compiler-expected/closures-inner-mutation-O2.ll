@@ -0,0 +1,17 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...) local_unnamed_addr
+
+; Function Attrs: nounwind
+define noundef i64 @main() local_unnamed_addr #0 {
+entry:
+  %0 = tail call i64 (ptr, ...) @printf(ptr nonnull @0, i64 0) #0
+  %1 = tail call i64 (ptr, ...) @printf(ptr nonnull @0, i64 1) #0
+  %2 = tail call i64 (ptr, ...) @printf(ptr nonnull @0, i64 2) #0
+  ret i64 0
+}
+
+attributes #0 = { nounwind }
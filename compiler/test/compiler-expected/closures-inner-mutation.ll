@@ -9,31 +9,35 @@ declare i64 @printf(ptr, ...)
 
 declare ptr @malloc(i64)
 
-define i64 @main({} %closure-env) {
+; Function Attrs: nounwind
+define i64 @main() #0 {
 entry:
   %counter = alloca i64, align 8
+  %"env:increment-counter" = alloca { ptr }, align 8
   store i64 0, ptr %counter, align 8
-  %0 = load i64, ptr %counter, align 8
-  %1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
-  %closure-arg = insertvalue { ptr } undef, ptr %counter, 0
-  %2 = call i64 @increment-counter({ ptr } %closure-arg)
-  %3 = load i64, ptr %counter, align 8
-  %4 = call i64 (ptr, ...) @printf(ptr @1, i64 %3)
-  %closure-arg1 = insertvalue { ptr } undef, ptr %counter, 0
-  %5 = call i64 @increment-counter({ ptr } %closure-arg1)
-  %6 = load i64, ptr %counter, align 8
-  %7 = call i64 (ptr, ...) @printf(ptr @2, i64 %6)
+  %0 = getelementptr inbounds { ptr }, ptr %"env:increment-counter", i32 0, i32 0
+  store ptr %counter, ptr %0, align 8
+  %1 = load i64, ptr %counter, align 8
+  %2 = call i64 (ptr, ...) @printf(ptr @0, i64 %1)
+  %3 = call tailcc i64 @increment-counter(ptr %"env:increment-counter")
+  %4 = load i64, ptr %counter, align 8
+  %5 = call i64 (ptr, ...) @printf(ptr @1, i64 %4)
+  %6 = call tailcc i64 @increment-counter(ptr %"env:increment-counter")
+  %7 = load i64, ptr %counter, align 8
+  %8 = call i64 (ptr, ...) @printf(ptr @2, i64 %7)
   ret i64 0
 }
 
-define i64 @increment-counter({ ptr } %closure-env) {
+; Function Attrs: nounwind willreturn
+define internal tailcc i64 @increment-counter(ptr %closure-env) #1 {
 entry:
-  %"closure-env:counter" = extractvalue { ptr } %closure-env, 0
-  %"closure-env:counter-ptr" = alloca ptr, align 8
-  store ptr %"closure-env:counter", ptr %"closure-env:counter-ptr", align 8
-  %0 = load ptr, ptr %"closure-env:counter-ptr", align 8
-  %1 = load i64, ptr %0, align 8
+  %0 = getelementptr inbounds { ptr }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:counter" = load ptr, ptr %0, align 8
+  %1 = load i64, ptr %"closure-env:counter", align 8
   %2 = add i64 %1, 1
-  store i64 %2, ptr %0, align 8
+  store i64 %2, ptr %"closure-env:counter", align 8
   ret i64 0
 }
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind willreturn }
@@ -0,0 +1,44 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@1 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@2 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @clamp(i64 %n) #0 {
+entry:
+  br label %if_branch
+
+if_branch:                                        ; preds = %entry
+  %0 = icmp ult i64 %n, 32
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %elif_body, label %else_branch
+
+elif_body:                                        ; preds = %if_branch
+  ret i64 %n
+
+else_branch:                                      ; preds = %if_branch
+  ret i64 32
+}
+
+; Function Attrs: nounwind
+define i64 @main() #1 {
+entry:
+  br label %if_branch
+
+if_branch:                                        ; preds = %entry
+  %0 = call i64 (ptr, ...) @printf(ptr @0, i64 1)
+  %1 = call tailcc i64 @clamp(i64 7)
+  %2 = call i64 (ptr, ...) @printf(ptr @1, i64 %1)
+  %3 = call tailcc i64 @clamp(i64 70)
+  %4 = call i64 (ptr, ...) @printf(ptr @2, i64 %3)
+  ret i64 0
+}
+
+attributes #0 = { nounwind willreturn memory(none) }
+attributes #1 = { nounwind }
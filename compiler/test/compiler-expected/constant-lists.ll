@@ -0,0 +1,73 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant { i64, [10 x i64] } { i64 10, [10 x i64] [i64 4, i64 3, i64 3, i64 5, i64 4, i64 4, i64 3, i64 5, i64 5, i64 4] }, align 8
+@1 = private unnamed_addr constant [5 x i8] c"zero\00", align 1
+@2 = private unnamed_addr constant [4 x i8] c"one\00", align 1
+@3 = private unnamed_addr constant [4 x i8] c"two\00", align 1
+@4 = private unnamed_addr constant [6 x i8] c"three\00", align 1
+@5 = private unnamed_addr constant [5 x i8] c"four\00", align 1
+@6 = private unnamed_addr constant [5 x i8] c"five\00", align 1
+@7 = private unnamed_addr constant [4 x i8] c"six\00", align 1
+@8 = private unnamed_addr constant [6 x i8] c"seven\00", align 1
+@9 = private unnamed_addr constant [6 x i8] c"eight\00", align 1
+@10 = private unnamed_addr constant [5 x i8] c"nine\00", align 1
+@11 = private unnamed_addr constant { i64, [10 x ptr] } { i64 10, [10 x ptr] [ptr @1, ptr @2, ptr @3, ptr @4, ptr @5, ptr @6, ptr @7, ptr @8, ptr @9, ptr @10] }, align 8
+@12 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@13 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@14 = private unnamed_addr constant [4 x i8] c"%s\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define internal tailcc i64 @name-length(i64 %digit) #0 {
+entry:
+  %0 = load i64, ptr @0, align 8
+  %1 = icmp ult i64 %digit, %0
+  br i1 %1, label %index_in_bounds, label %index_out_of_bounds
+
+index_out_of_bounds:                              ; preds = %entry
+  call void @kebab_index_error(i64 %digit, i64 %0) #1
+  unreachable
+
+index_in_bounds:                                  ; preds = %entry
+  %2 = getelementptr { i64, [0 x i64] }, ptr @0, i64 0, i32 1, i64 %digit
+  %3 = load i64, ptr %2, align 8
+  ret i64 %3
+}
+
+declare void @kebab_index_error(i64, i64)
+
+; Function Attrs: nounwind
+define internal tailcc ptr @name(i64 %digit) #0 {
+entry:
+  %0 = load i64, ptr @11, align 8
+  %1 = icmp ult i64 %digit, %0
+  br i1 %1, label %index_in_bounds, label %index_out_of_bounds
+
+index_out_of_bounds:                              ; preds = %entry
+  call void @kebab_index_error(i64 %digit, i64 %0) #1
+  unreachable
+
+index_in_bounds:                                  ; preds = %entry
+  %2 = getelementptr { i64, [0 x ptr] }, ptr @11, i64 0, i32 1, i64 %digit
+  %3 = load ptr, ptr %2, align 8
+  ret ptr %3
+}
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %0 = call tailcc i64 @name-length(i64 0)
+  %1 = call i64 (ptr, ...) @printf(ptr @12, i64 %0)
+  %2 = call tailcc i64 @name-length(i64 7)
+  %3 = call i64 (ptr, ...) @printf(ptr @13, i64 %2)
+  %4 = call tailcc ptr @name(i64 7)
+  %5 = call i64 (ptr, ...) @printf(ptr @14, ptr %4)
+  ret i64 0
+}
+
+attributes #0 = { nounwind }
+attributes #1 = { noreturn }
@@ -5,29 +5,29 @@ declare i64 @printf(ptr, ...)
 
 declare ptr @malloc(i64)
 
-define i64 @main({} %closure-env) {
+; Function Attrs: nounwind
+define i64 @main() #0 {
 entry:
   ret i64 0
 }
 
-define i64 @local({} %closure-env) {
+; Function Attrs: nounwind
+define internal tailcc i64 @local() #0 {
 entry:
-  %my-int = alloca i64, align 8
-  store i64 9, ptr %my-int, align 8
-  %closure-arg = insertvalue { ptr } undef, ptr %my-int, 0
-  %0 = call i64 @local-to-local({ ptr } %closure-arg)
-  %return = alloca i64, align 8
-  store i64 %0, ptr %return, align 8
-  %1 = load i64, ptr %return, align 8
-  ret i64 %1
+  %"env:local-to-local" = alloca { i64 }, align 8
+  %0 = getelementptr inbounds { i64 }, ptr %"env:local-to-local", i32 0, i32 0
+  store i64 9, ptr %0, align 8
+  %return = call tailcc i64 @local-to-local(ptr %"env:local-to-local")
+  ret i64 %return
 }
 
-define i64 @local-to-local({ ptr } %closure-env) {
+; Function Attrs: nounwind willreturn memory(read)
+define internal tailcc i64 @local-to-local(ptr %closure-env) #1 {
 entry:
-  %"closure-env:my-int" = extractvalue { ptr } %closure-env, 0
-  %"closure-env:my-int-ptr" = alloca ptr, align 8
-  store ptr %"closure-env:my-int", ptr %"closure-env:my-int-ptr", align 8
-  %0 = load ptr, ptr %"closure-env:my-int-ptr", align 8
-  %1 = load i64, ptr %0, align 8
-  ret i64 %1
+  %0 = getelementptr inbounds { i64 }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:my-int" = load i64, ptr %0, align 8
+  ret i64 %"closure-env:my-int"
 }
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind willreturn memory(read) }
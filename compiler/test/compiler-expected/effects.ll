@@ -0,0 +1,106 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@1 = private unnamed_addr constant { i64, [2 x i64] } { i64 2, [2 x i64] [i64 4, i64 5] }, align 8
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind willreturn memory(none)
+define internal tailcc i64 @square(i64 %n) #0 {
+entry:
+  %0 = mul i64 %n, %n
+  ret i64 %0
+}
+
+; Function Attrs: nounwind memory(read)
+define internal tailcc i64 @first(ptr %l) #1 {
+entry:
+  %0 = load i64, ptr %l, align 8
+  %1 = icmp ult i64 0, %0
+  br i1 %1, label %index_in_bounds, label %index_out_of_bounds
+
+index_out_of_bounds:                              ; preds = %entry
+  call void @kebab_index_error(i64 0, i64 %0) #5
+  unreachable
+
+index_in_bounds:                                  ; preds = %entry
+  %2 = getelementptr { i64, [0 x i64] }, ptr %l, i64 0, i32 1, i64 0
+  %3 = load i64, ptr %2, align 8
+  ret i64 %3
+}
+
+declare void @kebab_index_error(i64, i64)
+
+; Function Attrs: nounwind memory(none)
+define internal tailcc i64 @sum-to(i64 %n, i64 %acc) #2 {
+entry:
+  br label %tail_recursion
+
+tail_recursion:                                   ; preds = %else_branch, %entry
+  %"tail-recursion:n" = phi i64 [ %n, %entry ], [ %2, %else_branch ]
+  %"tail-recursion:acc" = phi i64 [ %acc, %entry ], [ %3, %else_branch ]
+  br label %if_branch
+
+if_branch:                                        ; preds = %tail_recursion
+  %0 = icmp eq i64 %"tail-recursion:n", 0
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %"tail-recursion:acc"
+
+else_branch:                                      ; preds = %if_branch
+  %2 = sub i64 %"tail-recursion:n", 1
+  %3 = add i64 %"tail-recursion:acc", %"tail-recursion:n"
+  br label %tail_recursion
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @show(i64 %n) #3 {
+entry:
+  %0 = call i64 (ptr, ...) @printf(ptr @0, i64 %n)
+  ret i64 %0
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @show-square(i64 %n) #3 {
+entry:
+  %0 = call tailcc i64 @square(i64 %n)
+  %1 = tail call tailcc i64 @show(i64 %0)
+  ret i64 %1
+}
+
+; Function Attrs: nounwind
+define i64 @main() #3 {
+entry:
+  %"env:shift" = alloca { i64 }, align 8
+  %0 = getelementptr inbounds { i64 }, ptr %"env:shift", i32 0, i32 0
+  store i64 3, ptr %0, align 8
+  %1 = call tailcc i64 @first(ptr @1)
+  %2 = call tailcc i64 @show-square(i64 %1)
+  %3 = call tailcc i64 @shift(i64 2, ptr %"env:shift")
+  %4 = call tailcc i64 @show(i64 %3)
+  %5 = call tailcc i64 @sum-to(i64 4, i64 0)
+  %6 = call tailcc i64 @show(i64 %5)
+  ret i64 0
+}
+
+; Function Attrs: nounwind willreturn memory(read)
+define internal tailcc i64 @shift(i64 %n, ptr %closure-env) #4 {
+entry:
+  %0 = getelementptr inbounds { i64 }, ptr %closure-env, i32 0, i32 0
+  %"closure-env:offset" = load i64, ptr %0, align 8
+  %1 = call tailcc i64 @square(i64 %n)
+  %2 = add i64 %1, %"closure-env:offset"
+  ret i64 %2
+}
+
+attributes #0 = { nounwind willreturn memory(none) }
+attributes #1 = { nounwind memory(read) }
+attributes #2 = { nounwind memory(none) }
+attributes #3 = { nounwind }
+attributes #4 = { nounwind willreturn memory(read) }
+attributes #5 = { noreturn }
@@ -0,0 +1,128 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant { i64, [3 x i64] } { i64 3, [3 x i64] [i64 1, i64 2, i64 3] }, align 8
+@1 = private unnamed_addr constant { i64, [5 x i64] } { i64 5, [5 x i64] [i64 4, i64 5, i64 6, i64 7, i64 8] }, align 8
+@2 = private unnamed_addr constant { i64, [2 x ptr] } { i64 2, [2 x ptr] [ptr @0, ptr @1] }, align 8
+@3 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@4 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@5 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@6 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind willreturn memory(read)
+define private i64 @len(ptr %list) #0 {
+entry:
+  %length = load i64, ptr %list, align 8
+  ret i64 %length
+}
+
+; Function Attrs: nounwind memory(read)
+define internal tailcc i64 @sum-from(ptr %numbers, i64 %i, i64 %acc) #1 {
+entry:
+  br label %tail_recursion
+
+tail_recursion:                                   ; preds = %index_in_bounds, %entry
+  %"tail-recursion:numbers" = phi ptr [ %numbers, %entry ], [ %"tail-recursion:numbers", %index_in_bounds ]
+  %"tail-recursion:i" = phi i64 [ %i, %entry ], [ %3, %index_in_bounds ]
+  %"tail-recursion:acc" = phi i64 [ %acc, %entry ], [ %8, %index_in_bounds ]
+  br label %if_branch
+
+if_branch:                                        ; preds = %tail_recursion
+  %0 = call i64 @len(ptr %"tail-recursion:numbers")
+  %1 = icmp eq i64 %"tail-recursion:i", %0
+  %2 = icmp eq i1 %1, true
+  br i1 %2, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %"tail-recursion:acc"
+
+else_branch:                                      ; preds = %if_branch
+  %3 = add i64 %"tail-recursion:i", 1
+  %4 = load i64, ptr %"tail-recursion:numbers", align 8
+  %5 = icmp ult i64 %"tail-recursion:i", %4
+  br i1 %5, label %index_in_bounds, label %index_out_of_bounds
+
+index_out_of_bounds:                              ; preds = %else_branch
+  call void @kebab_index_error(i64 %"tail-recursion:i", i64 %4) #3
+  unreachable
+
+index_in_bounds:                                  ; preds = %else_branch
+  %6 = getelementptr { i64, [0 x i64] }, ptr %"tail-recursion:numbers", i64 0, i32 1, i64 %"tail-recursion:i"
+  %7 = load i64, ptr %6, align 8
+  %8 = add i64 %"tail-recursion:acc", %7
+  br label %tail_recursion
+}
+
+declare void @kebab_index_error(i64, i64)
+
+; Function Attrs: nounwind memory(read)
+define internal tailcc i64 @sum(ptr %numbers) #1 {
+entry:
+  %0 = tail call tailcc i64 @sum-from(ptr %numbers, i64 0, i64 0)
+  ret i64 %0
+}
+
+; Function Attrs: nounwind memory(read)
+define internal tailcc i64 @total-length(ptr %lists) #1 {
+entry:
+  %0 = load i64, ptr %lists, align 8
+  %1 = icmp ult i64 0, %0
+  br i1 %1, label %index_in_bounds, label %index_out_of_bounds
+
+index_out_of_bounds:                              ; preds = %entry
+  call void @kebab_index_error(i64 0, i64 %0) #3
+  unreachable
+
+index_in_bounds:                                  ; preds = %entry
+  %2 = getelementptr { i64, [0 x ptr] }, ptr %lists, i64 0, i32 1, i64 0
+  %3 = load ptr, ptr %2, align 8
+  %4 = call i64 @len(ptr %3)
+  %5 = load i64, ptr %lists, align 8
+  %6 = icmp ult i64 1, %5
+  br i1 %6, label %index_in_bounds2, label %index_out_of_bounds1
+
+index_out_of_bounds1:                             ; preds = %index_in_bounds
+  call void @kebab_index_error(i64 1, i64 %5) #3
+  unreachable
+
+index_in_bounds2:                                 ; preds = %index_in_bounds
+  %7 = getelementptr { i64, [0 x ptr] }, ptr %lists, i64 0, i32 1, i64 1
+  %8 = load ptr, ptr %7, align 8
+  %9 = call i64 @len(ptr %8)
+  %10 = add i64 %4, %9
+  ret i64 %10
+}
+
+; Function Attrs: nounwind
+define i64 @main() #2 {
+entry:
+  %0 = call tailcc i64 @sum(ptr @0)
+  %1 = call i64 (ptr, ...) @printf(ptr @3, i64 %0)
+  %2 = call tailcc i64 @sum(ptr @1)
+  %3 = call i64 (ptr, ...) @printf(ptr @4, i64 %2)
+  %4 = call tailcc i64 @total-length(ptr @2)
+  %5 = call i64 (ptr, ...) @printf(ptr @5, i64 %4)
+  %6 = load ptr, ptr getelementptr ({ i64, [0 x ptr] }, ptr @2, i64 0, i32 1, i64 1), align 8
+  %7 = load i64, ptr %6, align 8
+  %8 = icmp ult i64 4, %7
+  br i1 %8, label %index_in_bounds, label %index_out_of_bounds
+
+index_out_of_bounds:                              ; preds = %entry
+  call void @kebab_index_error(i64 4, i64 %7) #3
+  unreachable
+
+index_in_bounds:                                  ; preds = %entry
+  %9 = getelementptr { i64, [0 x i64] }, ptr %6, i64 0, i32 1, i64 4
+  %10 = load i64, ptr %9, align 8
+  %11 = call i64 (ptr, ...) @printf(ptr @6, i64 %10)
+  ret i64 0
+}
+
+attributes #0 = { nounwind willreturn memory(read) }
+attributes #1 = { nounwind memory(read) }
+attributes #2 = { nounwind }
+attributes #3 = { noreturn }
@@ -7,11 +7,11 @@ declare i64 @printf(ptr, ...)
 
 declare ptr @malloc(i64)
 
-define i64 @main(i64 %argc, {} %closure-env) {
+; Function Attrs: nounwind
+define i64 @main(i64 %argc) #0 {
 entry:
-  %"arg:argc" = alloca i64, align 8
-  store i64 %argc, ptr %"arg:argc", align 8
-  %0 = load i64, ptr %"arg:argc", align 8
-  %1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
+  %0 = call i64 (ptr, ...) @printf(ptr @0, i64 %argc)
   ret i64 0
 }
+
+attributes #0 = { nounwind }
@@ -0,0 +1,141 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@fib.memo-table = internal global [4096 x { i1, i64, i64 }] zeroinitializer
+@paths.memo-table = internal global [4096 x { i1, i64, i64, i64 }] zeroinitializer
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@1 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define internal tailcc i64 @fib(i64 %n) #0 {
+entry:
+  br label %if_branch
+
+if_branch:                                        ; preds = %entry
+  %0 = icmp ult i64 %n, 2
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %n
+
+else_branch:                                      ; preds = %if_branch
+  %2 = sub i64 %n, 1
+  %3 = call tailcc i64 @fib.memo(i64 %2)
+  %4 = sub i64 %n, 2
+  %5 = call tailcc i64 @fib.memo(i64 %4)
+  %6 = add i64 %3, %5
+  ret i64 %6
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @fib.memo(i64 %n) #0 {
+entry:
+  %0 = mul i64 %n, -7046029254386353131
+  %1 = lshr i64 %0, 52
+  %2 = getelementptr inbounds [4096 x { i1, i64, i64 }], ptr @fib.memo-table, i64 0, i64 %1
+  %3 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 0
+  %4 = load i1, ptr %3, align 1
+  %5 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 1
+  %6 = load i64, ptr %5, align 8
+  %7 = icmp eq i64 %6, %n
+  %8 = and i1 %4, %7
+  %9 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 2
+  br i1 %8, label %cached, label %uncached
+
+cached:                                           ; preds = %entry
+  %10 = load i64, ptr %9, align 8
+  ret i64 %10
+
+uncached:                                         ; preds = %entry
+  %11 = call tailcc i64 @fib(i64 %n)
+  %12 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 0
+  store i1 true, ptr %12, align 1
+  %13 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 1
+  store i64 %n, ptr %13, align 8
+  store i64 %11, ptr %9, align 8
+  ret i64 %11
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @paths(i64 %rows, i64 %columns) #0 {
+entry:
+  br label %if_branch
+
+if_branch:                                        ; preds = %entry
+  %0 = icmp eq i64 %rows, 0
+  br i1 %0, label %or_merge, label %or_rhs
+
+or_rhs:                                           ; preds = %if_branch
+  %1 = icmp eq i64 %columns, 0
+  br label %or_merge
+
+or_merge:                                         ; preds = %or_rhs, %if_branch
+  %2 = phi i1 [ true, %if_branch ], [ %1, %or_rhs ]
+  %3 = icmp eq i1 %2, true
+  br i1 %3, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %or_merge
+  ret i64 1
+
+else_branch:                                      ; preds = %or_merge
+  %4 = sub i64 %rows, 1
+  %5 = call tailcc i64 @paths.memo(i64 %4, i64 %columns)
+  %6 = sub i64 %columns, 1
+  %7 = call tailcc i64 @paths.memo(i64 %rows, i64 %6)
+  %8 = add i64 %5, %7
+  ret i64 %8
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @paths.memo(i64 %rows, i64 %columns) #0 {
+entry:
+  %0 = mul i64 %rows, -7046029254386353131
+  %1 = xor i64 %0, %columns
+  %2 = mul i64 %1, -7046029254386353131
+  %3 = lshr i64 %2, 52
+  %4 = getelementptr inbounds [4096 x { i1, i64, i64, i64 }], ptr @paths.memo-table, i64 0, i64 %3
+  %5 = getelementptr inbounds { i1, i64, i64, i64 }, ptr %4, i32 0, i32 0
+  %6 = load i1, ptr %5, align 1
+  %7 = getelementptr inbounds { i1, i64, i64, i64 }, ptr %4, i32 0, i32 1
+  %8 = load i64, ptr %7, align 8
+  %9 = icmp eq i64 %8, %rows
+  %10 = and i1 %6, %9
+  %11 = getelementptr inbounds { i1, i64, i64, i64 }, ptr %4, i32 0, i32 2
+  %12 = load i64, ptr %11, align 8
+  %13 = icmp eq i64 %12, %columns
+  %14 = and i1 %10, %13
+  %15 = getelementptr inbounds { i1, i64, i64, i64 }, ptr %4, i32 0, i32 3
+  br i1 %14, label %cached, label %uncached
+
+cached:                                           ; preds = %entry
+  %16 = load i64, ptr %15, align 8
+  ret i64 %16
+
+uncached:                                         ; preds = %entry
+  %17 = call tailcc i64 @paths(i64 %rows, i64 %columns)
+  %18 = getelementptr inbounds { i1, i64, i64, i64 }, ptr %4, i32 0, i32 0
+  store i1 true, ptr %18, align 1
+  %19 = getelementptr inbounds { i1, i64, i64, i64 }, ptr %4, i32 0, i32 1
+  store i64 %rows, ptr %19, align 8
+  %20 = getelementptr inbounds { i1, i64, i64, i64 }, ptr %4, i32 0, i32 2
+  store i64 %columns, ptr %20, align 8
+  store i64 %17, ptr %15, align 8
+  ret i64 %17
+}
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %0 = call tailcc i64 @fib.memo(i64 90)
+  %1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
+  %2 = call tailcc i64 @paths.memo(i64 16, i64 16)
+  %3 = call i64 (ptr, ...) @printf(ptr @1, i64 %2)
+  ret i64 0
+}
+
+attributes #0 = { nounwind }
@@ -0,0 +1,38 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@1 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind willreturn memory(none)
+define tailcc i64 @double(i64 %n) #0 {
+entry:
+  %0 = mul i64 %n, 2
+  ret i64 %0
+}
+
+; Function Attrs: nounwind
+declare tailcc i64 @steps(i64) #1
+
+; Function Attrs: nounwind
+declare tailcc i64 @steps.memo(i64) #1
+
+; Function Attrs: nounwind willreturn memory(none)
+declare tailcc i64 @quadruple(i64) #0
+
+; Function Attrs: nounwind
+define i64 @main() #1 {
+entry:
+  %0 = call tailcc i64 @quadruple(i64 5)
+  %i1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
+  %1 = call tailcc i64 @steps.memo(i64 1024)
+  %i2 = call i64 (ptr, ...) @printf(ptr @1, i64 %1)
+  ret i64 0
+}
+
+attributes #0 = { nounwind willreturn memory(none) }
+attributes #1 = { nounwind }
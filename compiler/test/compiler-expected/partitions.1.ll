@@ -0,0 +1,69 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@steps.memo-table = internal global [4096 x { i1, i64, i64 }] zeroinitializer
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind willreturn memory(none)
+declare tailcc i64 @double(i64) #0
+
+; Function Attrs: nounwind
+define tailcc i64 @steps(i64 %n) #1 {
+entry:
+  br label %if_branch
+
+if_branch:                                        ; preds = %entry
+  %0 = icmp ult i64 %n, 2
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 0
+
+else_branch:                                      ; preds = %if_branch
+  %2 = sdiv i64 %n, 2
+  %3 = call tailcc i64 @steps.memo(i64 %2)
+  %4 = add i64 1, %3
+  ret i64 %4
+}
+
+; Function Attrs: nounwind
+define tailcc i64 @steps.memo(i64 %n) #1 {
+entry:
+  %0 = mul i64 %n, -7046029254386353131
+  %1 = lshr i64 %0, 52
+  %2 = getelementptr inbounds [4096 x { i1, i64, i64 }], ptr @steps.memo-table, i64 0, i64 %1
+  %3 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 0
+  %4 = load i1, ptr %3, align 1
+  %5 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 1
+  %6 = load i64, ptr %5, align 8
+  %7 = icmp eq i64 %6, %n
+  %8 = and i1 %4, %7
+  %9 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 2
+  br i1 %8, label %cached, label %uncached
+
+cached:                                           ; preds = %entry
+  %10 = load i64, ptr %9, align 8
+  ret i64 %10
+
+uncached:                                         ; preds = %entry
+  %11 = call tailcc i64 @steps(i64 %n)
+  %12 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 0
+  store i1 true, ptr %12, align 1
+  %13 = getelementptr inbounds { i1, i64, i64 }, ptr %2, i32 0, i32 1
+  store i64 %n, ptr %13, align 8
+  store i64 %11, ptr %9, align 8
+  ret i64 %11
+}
+
+; Function Attrs: nounwind willreturn memory(none)
+declare tailcc i64 @quadruple(i64) #0
+
+; Function Attrs: nounwind
+declare i64 @main() #1
+
+attributes #0 = { nounwind willreturn memory(none) }
+attributes #1 = { nounwind }
@@ -0,0 +1,29 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind willreturn memory(none)
+declare tailcc i64 @double(i64) #0
+
+; Function Attrs: nounwind
+declare tailcc i64 @steps(i64) #1
+
+; Function Attrs: nounwind
+declare tailcc i64 @steps.memo(i64) #1
+
+; Function Attrs: nounwind willreturn memory(none)
+define tailcc i64 @quadruple(i64 %n) #0 {
+entry:
+  %0 = call tailcc i64 @double(i64 %n)
+  %1 = tail call tailcc i64 @double(i64 %0)
+  ret i64 %1
+}
+
+; Function Attrs: nounwind
+declare i64 @main() #1
+
+attributes #0 = { nounwind willreturn memory(none) }
+attributes #1 = { nounwind }
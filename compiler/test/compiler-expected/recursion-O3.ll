@@ -0,0 +1,60 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...) local_unnamed_addr
+
+; Function Attrs: nofree nosync nounwind memory(none)
+define internal tailcc i64 @fib(i64 range(i64 0, 11) %n) unnamed_addr #0 {
+entry:
+  %0 = icmp samesign ult i64 %n, 2
+  br i1 %0, label %common.ret, label %else_branch
+
+common.ret:                                       ; preds = %else_branch, %entry
+  %accumulator.tr.lcssa = phi i64 [ 0, %entry ], [ %4, %else_branch ]
+  %n.tr.lcssa = phi i64 [ %n, %entry ], [ %3, %else_branch ]
+  %accumulator.ret.tr = add i64 %n.tr.lcssa, %accumulator.tr.lcssa
+  ret i64 %accumulator.ret.tr
+
+else_branch:                                      ; preds = %entry, %else_branch
+  %n.tr2 = phi i64 [ %3, %else_branch ], [ %n, %entry ]
+  %accumulator.tr1 = phi i64 [ %4, %else_branch ], [ 0, %entry ]
+  %1 = add nsw i64 %n.tr2, -1
+  %2 = tail call tailcc i64 @fib(i64 %1)
+  %3 = add nsw i64 %n.tr2, -2
+  %4 = add i64 %2, %accumulator.tr1
+  %5 = icmp samesign ult i64 %n.tr2, 4
+  br i1 %5, label %common.ret, label %else_branch
+}
+
+; Function Attrs: nofree nosync nounwind memory(none)
+define internal tailcc range(i64 0, -1) i64 @exp(i64 range(i64 1, 11) %exponent) unnamed_addr #0 {
+entry:
+  %0 = icmp eq i64 %exponent, 1
+  br i1 %0, label %common.ret, label %else_branch
+
+common.ret:                                       ; preds = %entry, %else_branch
+  %common.ret.op = phi i64 [ %3, %else_branch ], [ 2, %entry ]
+  ret i64 %common.ret.op
+
+else_branch:                                      ; preds = %entry
+  %1 = add nsw i64 %exponent, -1
+  %2 = tail call tailcc i64 @exp(i64 %1)
+  %3 = shl i64 %2, 1
+  br label %common.ret
+}
+
+; Function Attrs: nounwind
+define noundef i64 @main() local_unnamed_addr #1 {
+entry:
+  %0 = tail call tailcc i64 @fib(i64 10)
+  %i1 = tail call i64 (ptr, ...) @printf(ptr nonnull @0, i64 %0) #1
+  %i2 = tail call i64 (ptr, ...) @printf(ptr nonnull @0, i64 3628800) #1
+  %1 = tail call tailcc i64 @exp(i64 10)
+  %i3 = tail call i64 (ptr, ...) @printf(ptr nonnull @0, i64 %1) #1
+  ret i64 0
+}
+
+attributes #0 = { nofree nosync nounwind memory(none) }
+attributes #1 = { nounwind }
@@ -9,102 +9,79 @@ declare i64 @printf(ptr, ...)
 
 declare ptr @malloc(i64)
 
-define i64 @fib(i64 %n, {} %closure-env) {
+; Function Attrs: nounwind memory(none)
+define internal tailcc i64 @fib(i64 %n) #0 {
 entry:
-  %"arg:n" = alloca i64, align 8
-  store i64 %n, ptr %"arg:n", align 8
   br label %if_branch
 
 if_branch:                                        ; preds = %entry
-  %0 = load i64, ptr %"arg:n", align 8
-  %1 = icmp ult i64 %0, 2
-  %2 = icmp eq i1 %1, true
-  %3 = load i64, ptr %"arg:n", align 8
-  br i1 %2, label %merge_branch, label %else_branch
-
-merge_branch:                                     ; preds = %else_branch, %if_branch
-  %4 = phi i64 [ %3, %if_branch ], [ %11, %else_branch ]
-  ret i64 %4
+  %0 = icmp ult i64 %n, 2
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %n
 
 else_branch:                                      ; preds = %if_branch
-  %5 = load i64, ptr %"arg:n", align 8
-  %6 = sub i64 %5, 1
-  %7 = call i64 @fib(i64 %6, {} undef)
-  %8 = load i64, ptr %"arg:n", align 8
-  %9 = sub i64 %8, 2
-  %10 = call i64 @fib(i64 %9, {} undef)
-  %11 = add i64 %7, %10
-  br label %merge_branch
+  %2 = sub i64 %n, 1
+  %3 = call tailcc i64 @fib(i64 %2)
+  %4 = sub i64 %n, 2
+  %5 = call tailcc i64 @fib(i64 %4)
+  %6 = add i64 %3, %5
+  ret i64 %6
 }
 
-define i64 @fac(i64 %n, {} %closure-env) {
+; Function Attrs: nounwind memory(none)
+define internal tailcc i64 @fac(i64 %n) #0 {
 entry:
-  %"arg:n" = alloca i64, align 8
-  store i64 %n, ptr %"arg:n", align 8
   br label %if_branch
 
 if_branch:                                        ; preds = %entry
-  %0 = load i64, ptr %"arg:n", align 8
-  %1 = icmp ule i64 %0, 1
-  %2 = icmp eq i1 %1, true
-  %3 = load i64, ptr %"arg:n", align 8
-  br i1 %2, label %merge_branch, label %else_branch
-
-merge_branch:                                     ; preds = %else_branch, %if_branch
-  %4 = phi i64 [ %3, %if_branch ], [ %9, %else_branch ]
-  ret i64 %4
+  %0 = icmp ule i64 %n, 1
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %n
 
 else_branch:                                      ; preds = %if_branch
-  %5 = load i64, ptr %"arg:n", align 8
-  %6 = load i64, ptr %"arg:n", align 8
-  %7 = sub i64 %6, 1
-  %8 = call i64 @fac(i64 %7, {} undef)
-  %9 = mul i64 %5, %8
-  br label %merge_branch
+  %2 = sub i64 %n, 1
+  %3 = call tailcc i64 @fac(i64 %2)
+  %4 = mul i64 %n, %3
+  ret i64 %4
 }
 
-define i64 @exp(i64 %base, i64 %exponent, {} %closure-env) {
+; Function Attrs: nounwind memory(none)
+define internal tailcc i64 @exp(i64 %base, i64 %exponent) #0 {
 entry:
-  %"arg:base" = alloca i64, align 8
-  store i64 %base, ptr %"arg:base", align 8
-  %"arg:exponent" = alloca i64, align 8
-  store i64 %exponent, ptr %"arg:exponent", align 8
   br label %if_branch
 
 if_branch:                                        ; preds = %entry
-  %0 = load i64, ptr %"arg:exponent", align 8
-  %1 = icmp eq i64 %0, 1
-  %2 = icmp eq i1 %1, true
-  %3 = load i64, ptr %"arg:base", align 8
-  br i1 %2, label %merge_branch, label %else_branch
-
-merge_branch:                                     ; preds = %else_branch, %if_branch
-  %4 = phi i64 [ %3, %if_branch ], [ %10, %else_branch ]
-  ret i64 %4
+  %0 = icmp eq i64 %exponent, 1
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %base
 
 else_branch:                                      ; preds = %if_branch
-  %5 = load i64, ptr %"arg:base", align 8
-  %6 = load i64, ptr %"arg:base", align 8
-  %7 = load i64, ptr %"arg:exponent", align 8
-  %8 = sub i64 %7, 1
-  %9 = call i64 @exp(i64 %6, i64 %8, {} undef)
-  %10 = mul i64 %5, %9
-  br label %merge_branch
+  %2 = sub i64 %exponent, 1
+  %3 = call tailcc i64 @exp(i64 %base, i64 %2)
+  %4 = mul i64 %base, %3
+  ret i64 %4
 }
 
-define i64 @main({} %closure-env) {
+; Function Attrs: nounwind
+define i64 @main() #1 {
 entry:
-  %0 = call i64 @fib(i64 10, {} undef)
-  %1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
-  %i1 = alloca i64, align 8
-  store i64 %1, ptr %i1, align 8
-  %2 = call i64 @fac(i64 10, {} undef)
-  %3 = call i64 (ptr, ...) @printf(ptr @1, i64 %2)
-  %i2 = alloca i64, align 8
-  store i64 %3, ptr %i2, align 8
-  %4 = call i64 @exp(i64 2, i64 10, {} undef)
-  %5 = call i64 (ptr, ...) @printf(ptr @2, i64 %4)
-  %i3 = alloca i64, align 8
-  store i64 %5, ptr %i3, align 8
+  %0 = call tailcc i64 @fib(i64 10)
+  %i1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
+  %1 = call tailcc i64 @fac(i64 10)
+  %i2 = call i64 (ptr, ...) @printf(ptr @1, i64 %1)
+  %2 = call tailcc i64 @exp(i64 2, i64 10)
+  %i3 = call i64 (ptr, ...) @printf(ptr @2, i64 %2)
   ret i64 0
 }
+
+attributes #0 = { nounwind memory(none) }
+attributes #1 = { nounwind }
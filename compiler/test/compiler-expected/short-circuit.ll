@@ -0,0 +1,59 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [11 x i8] c"evaluated\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define internal tailcc i1 @noisy(i1 %result) #0 {
+entry:
+  %printed = call i64 (ptr, ...) @printf(ptr @0)
+  ret i1 %result
+}
+
+; Function Attrs: nounwind
+define internal tailcc i1 @both(i64 %n) #0 {
+entry:
+  %0 = icmp sgt i64 %n, 0
+  br i1 %0, label %and_rhs, label %and_merge
+
+and_rhs:                                          ; preds = %entry
+  %1 = icmp ult i64 %n, 10
+  %2 = call tailcc i1 @noisy(i1 %1)
+  br label %and_merge
+
+and_merge:                                        ; preds = %and_rhs, %entry
+  %3 = phi i1 [ false, %entry ], [ %2, %and_rhs ]
+  ret i1 %3
+}
+
+; Function Attrs: nounwind
+define internal tailcc i1 @either(i64 %n) #0 {
+entry:
+  %0 = icmp sgt i64 %n, 0
+  br i1 %0, label %or_merge, label %or_rhs
+
+or_rhs:                                           ; preds = %entry
+  %1 = icmp ult i64 %n, 10
+  %2 = call tailcc i1 @noisy(i1 %1)
+  br label %or_merge
+
+or_merge:                                         ; preds = %or_rhs, %entry
+  %3 = phi i1 [ true, %entry ], [ %2, %or_rhs ]
+  ret i1 %3
+}
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %b1 = call tailcc i1 @both(i64 5)
+  %b2 = call tailcc i1 @both(i64 -1)
+  %b3 = call tailcc i1 @either(i64 5)
+  %b4 = call tailcc i1 @either(i64 -1)
+  ret i64 0
+}
+
+attributes #0 = { nounwind }
@@ -0,0 +1,86 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind
+define internal tailcc i64 @sum-window(i64 %n) #0 {
+entry:
+  %window = alloca { i64, [3 x i64] }, align 8
+  %0 = add i64 %n, 1
+  %1 = add i64 %n, 2
+  %2 = getelementptr inbounds { i64, [3 x i64] }, ptr %window, i32 0, i32 0
+  store i64 3, ptr %2, align 8
+  %3 = getelementptr { i64, [3 x i64] }, ptr %window, i64 0, i32 1, i64 0
+  store i64 %n, ptr %3, align 8
+  %4 = getelementptr { i64, [3 x i64] }, ptr %window, i64 0, i32 1, i64 1
+  store i64 %0, ptr %4, align 8
+  %5 = getelementptr { i64, [3 x i64] }, ptr %window, i64 0, i32 1, i64 2
+  store i64 %1, ptr %5, align 8
+  %6 = getelementptr { i64, [0 x i64] }, ptr %window, i64 0, i32 1, i64 0
+  %7 = load i64, ptr %6, align 8
+  %8 = getelementptr { i64, [0 x i64] }, ptr %window, i64 0, i32 1, i64 1
+  %9 = load i64, ptr %8, align 8
+  %10 = add i64 %7, %9
+  %11 = getelementptr { i64, [0 x i64] }, ptr %window, i64 0, i32 1, i64 2
+  %12 = load i64, ptr %11, align 8
+  %13 = add i64 %10, %12
+  ret i64 %13
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @sum-windows(i64 %n, i64 %acc) #0 {
+entry:
+  br label %tail_recursion
+
+tail_recursion:                                   ; preds = %else_branch, %entry
+  %"tail-recursion:n" = phi i64 [ %n, %entry ], [ %2, %else_branch ]
+  %"tail-recursion:acc" = phi i64 [ %acc, %entry ], [ %4, %else_branch ]
+  br label %if_branch
+
+if_branch:                                        ; preds = %tail_recursion
+  %0 = icmp eq i64 %"tail-recursion:n", 0
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %else_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %"tail-recursion:acc"
+
+else_branch:                                      ; preds = %if_branch
+  %2 = sub i64 %"tail-recursion:n", 1
+  %3 = call tailcc i64 @sum-window(i64 %"tail-recursion:n")
+  %4 = add i64 %"tail-recursion:acc", %3
+  br label %tail_recursion
+}
+
+; Function Attrs: nounwind
+define internal tailcc i64 @sum-range(i64 %n) #0 {
+entry:
+  %range = alloca { i64, [2 x i64] }, align 8
+  %0 = getelementptr inbounds { i64, [2 x i64] }, ptr %range, i32 0, i32 0
+  store i64 2, ptr %0, align 8
+  %1 = getelementptr { i64, [2 x i64] }, ptr %range, i64 0, i32 1, i64 0
+  store i64 %n, ptr %1, align 8
+  %2 = getelementptr { i64, [2 x i64] }, ptr %range, i64 0, i32 1, i64 1
+  store i64 0, ptr %2, align 8
+  %3 = getelementptr { i64, [0 x i64] }, ptr %range, i64 0, i32 1, i64 0
+  %4 = load i64, ptr %3, align 8
+  %5 = getelementptr { i64, [0 x i64] }, ptr %range, i64 0, i32 1, i64 1
+  %6 = load i64, ptr %5, align 8
+  %7 = tail call tailcc i64 @sum-windows(i64 %4, i64 %6)
+  ret i64 %7
+}
+
+; Function Attrs: nounwind
+define i64 @main() #0 {
+entry:
+  %0 = call tailcc i64 @sum-range(i64 100000)
+  %1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
+  ret i64 0
+}
+
+attributes #0 = { nounwind }
@@ -1,44 +1,23 @@
 ; ModuleID = 'kebab'
 source_filename = "kebab"
 
-@0 = private unnamed_addr constant [6 x i8] c"hello\00", align 1
-@1 = private unnamed_addr constant [6 x i8] c"world\00", align 1
-@2 = private unnamed_addr constant [20 x i8] c"num: %ld, word: %s\0A\00", align 1
+@0 = private unnamed_addr constant { i64, [3 x i64] } { i64 3, [3 x i64] [i64 1, i64 2, i64 3] }, align 8
+@1 = private unnamed_addr constant [6 x i8] c"hello\00", align 1
+@2 = private unnamed_addr constant [6 x i8] c"world\00", align 1
+@3 = private unnamed_addr constant { i64, [2 x ptr] } { i64 2, [2 x ptr] [ptr @1, ptr @2] }, align 8
+@4 = private unnamed_addr constant [20 x i8] c"num: %ld, word: %s\0A\00", align 1
 
 declare i64 @printf(ptr, ...)
 
 declare ptr @malloc(i64)
 
-define i64 @main({} %closure-env) {
+; Function Attrs: nounwind
+define i64 @main() #0 {
 entry:
-  %0 = call ptr @malloc(i64 24)
-  %1 = getelementptr i64, ptr %0, i64 0
-  store i64 1, ptr %1, align 8
-  %2 = getelementptr i64, ptr %0, i64 1
-  store i64 2, ptr %2, align 8
-  %3 = getelementptr i64, ptr %0, i64 2
-  store i64 3, ptr %3, align 8
-  %numbers = alloca ptr, align 8
-  store ptr %0, ptr %numbers, align 8
-  %4 = call ptr @malloc(i64 0)
-  %5 = getelementptr ptr, ptr %4, i64 0
-  store ptr @0, ptr %5, align 8
-  %6 = getelementptr ptr, ptr %4, i64 1
-  store ptr @1, ptr %6, align 8
-  %words = alloca ptr, align 8
-  store ptr %4, ptr %words, align 8
-  %7 = load ptr, ptr %numbers, align 8
-  %8 = getelementptr i64, ptr %7, i64 1
-  %9 = load i64, ptr %8, align 8
-  %number = alloca i64, align 8
-  store i64 %9, ptr %number, align 8
-  %10 = load ptr, ptr %words, align 8
-  %11 = getelementptr ptr, ptr %10, i64 0
-  %12 = load ptr, ptr %11, align 8
-  %word = alloca ptr, align 8
-  store ptr %12, ptr %word, align 8
-  %13 = load i64, ptr %number, align 8
-  %14 = load ptr, ptr %word, align 8
-  %15 = call i64 (ptr, ...) @printf(ptr @2, i64 %13, ptr %14)
+  %number = load i64, ptr getelementptr ({ i64, [0 x i64] }, ptr @0, i64 0, i32 1, i64 1), align 8
+  %word = load ptr, ptr getelementptr ({ i64, [0 x ptr] }, ptr @3, i64 0, i32 1, i64 0), align 8
+  %0 = call i64 (ptr, ...) @printf(ptr @4, i64 %number, ptr %word)
   ret i64 0
 }
+
+attributes #0 = { nounwind }
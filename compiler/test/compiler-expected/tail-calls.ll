@@ -0,0 +1,62 @@
+; ModuleID = 'kebab'
+source_filename = "kebab"
+
+@0 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+@1 = private unnamed_addr constant [5 x i8] c"%ld\0A\00", align 1
+
+declare i64 @printf(ptr, ...)
+
+declare ptr @malloc(i64)
+
+; Function Attrs: nounwind memory(none)
+define internal tailcc i64 @count-down(i64 %n, i64 %acc) #0 {
+entry:
+  br label %tail_recursion
+
+tail_recursion:                                   ; preds = %else_branch, %elif_body, %entry
+  %"tail-recursion:n" = phi i64 [ %n, %entry ], [ 0, %elif_body ], [ %5, %else_branch ]
+  %"tail-recursion:acc" = phi i64 [ %acc, %entry ], [ %4, %elif_body ], [ %6, %else_branch ]
+  br label %if_branch
+
+if_branch:                                        ; preds = %tail_recursion
+  %0 = icmp eq i64 %"tail-recursion:n", 0
+  %1 = icmp eq i1 %0, true
+  br i1 %1, label %if_body, label %elif_branch
+
+if_body:                                          ; preds = %if_branch
+  ret i64 %"tail-recursion:acc"
+
+elif_branch:                                      ; preds = %if_branch
+  %2 = icmp eq i64 %"tail-recursion:n", 1
+  %3 = icmp eq i1 %2, true
+  br i1 %3, label %elif_body, label %else_branch
+
+elif_body:                                        ; preds = %elif_branch
+  %4 = add i64 %"tail-recursion:acc", 1
+  br label %tail_recursion
+
+else_branch:                                      ; preds = %elif_branch
+  %5 = sub i64 %"tail-recursion:n", 1
+  %6 = add i64 %"tail-recursion:acc", 1
+  br label %tail_recursion
+}
+
+; Function Attrs: nounwind memory(none)
+define internal tailcc i64 @count(i64 %n) #0 {
+entry:
+  %0 = tail call tailcc i64 @count-down(i64 %n, i64 0)
+  ret i64 %0
+}
+
+; Function Attrs: nounwind
+define i64 @main() #1 {
+entry:
+  %0 = call tailcc i64 @count(i64 10000000)
+  %1 = call i64 (ptr, ...) @printf(ptr @0, i64 %0)
+  %2 = call tailcc i64 @count(i64 3)
+  %3 = call i64 (ptr, ...) @printf(ptr @1, i64 %2)
+  ret i64 0
+}
+
+attributes #0 = { nounwind memory(none) }
+attributes #1 = { nounwind }